@@ -1,19 +1,15 @@
 #!/bin/bash
 
 # =================================================================
-# SCRIPT MAESTRO PARA EXPERIMENTOS MASIVOS (Vía Makefile)
+# SCRIPT MAESTRO PARA EXPERIMENTOS MASIVOS (Vía spp_solver --batch)
 # =================================================================
+#
+# La grilla (instancias × zonas × alphas × repeticiones) se define en un
+# archivo de trabajos (por defecto jobs.txt). Todo corre en un solo proceso
+# que carga cada instancia una vez y reparte las ejecuciones entre hilos.
 
-INSTANCIAS=(
-    "Medianas/mediana_1.spp"
-    # "Medianas/mediana_2.spp"
-    # "Medianas/mediana_3.spp"
-    # "Pequeñas/pequena_4.spp"
-    # "Pequeñas/pequena_5.spp"
-)
-
-ZONAS_LISTA=(5 6) #agregar 5 6 
-ALPHAS_LISTA=(0.2) #agregar 0.2
+JOBS=${1:-jobs.txt}
+HILOS=${HILOS:-0} # 0 = todos los núcleos
 
 echo "============================================="
 echo " PREPARANDO ENTORNO "
@@ -30,27 +26,12 @@ fi
 # =================================================================
 # 2. Ejecución de Experimentos
 # =================================================================
-total_experimentos=$(( ${#INSTANCIAS[@]} * ${#ZONAS_LISTA[@]} * ${#ALPHAS_LISTA[@]} ))
-contador=1
-
-for INST in "${INSTANCIAS[@]}"; do
-    for Z in "${ZONAS_LISTA[@]}"; do
-        for A in "${ALPHAS_LISTA[@]}"; do
-            
-            echo ""
-            echo "------------------------------------------------------------------"
-            echo "EXPERIMENTO $contador DE $total_experimentos"
-            echo "Instancia: $INST | Zonas: $Z | Alpha: $A"
-            echo "------------------------------------------------------------------"
-            
-            ./run.sh "$INST" "$Z" "$A"
-            
-            ((contador++))
-            
-        done
-    done
-done
+./spp_solver --batch "$JOBS" --threads "$HILOS"
 
+if [ $? -ne 0 ]; then
+    echo "Error crítico: el batch falló."
+    exit 1
+fi
 
 echo ""
 echo "============================================="
@@ -59,4 +40,4 @@ echo "============================================="
 
 make clean
 
-echo "Todo listo. Datos en carpeta 'test_results'."
\ No newline at end of file
+echo "Todo listo. Para graficar: python graph.py data_csv/<salida>_ejecuciones.csv"
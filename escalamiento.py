@@ -0,0 +1,146 @@
+"""
+Barrido de escalamiento del solver sobre terrenos sintéticos.
+
+Genera (si faltan) mapas cuadrados de cada lado con spp_generador en
+instances/Sinteticas/ y corre spp_solver sobre la grilla lados x zonas x hilos,
+leyendo de --stats el tiempo de búsqueda, los movimientos evaluados y el pico
+de memoria (RSS). Cada fila se escribe apenas termina su ejecución, así que
+un barrido cortado a la mitad deja resultados utilizables.
+
+Uso:
+    python escalamiento.py [--lados 50,100,...] [--zonas 4,16] [--hilos 1,2,4]
+                           [--alpha 0.5] [--restarts N] [--time-limit SEG]
+                           [--semilla S] [--salida data_csv/escalamiento.csv]
+                           [--extra "--estrategia teselas"]
+
+Después: python graph.py --escalamiento data_csv/escalamiento.csv
+"""
+import argparse
+import csv
+import json
+import os
+import shlex
+import subprocess
+import sys
+import tempfile
+import time
+
+DIR_INSTANCIAS = "instances"
+DIR_SINTETICAS = "Sinteticas"
+SOLVER = "./spp_solver"
+GENERADOR = "./spp_generador"
+
+COLUMNAS = ["Lado", "Celdas", "Zonas", "Hilos", "Restarts", "Alpha", "Costo",
+            "Tiempo_Lectura", "Tiempo_Busqueda", "Tiempo_Total",
+            "Evaluaciones", "Evaluaciones_Por_Segundo", "Memoria_Pico_MB"]
+
+
+def lista_enteros(texto):
+    return [int(x) for x in texto.split(",") if x.strip()]
+
+
+def compilar(objetivo, binario, por_defecto):
+    """Corre siempre `make` (es incremental): un binario viejo mediría código
+    que ya no está. Un --solver/--generador propio se usa tal cual."""
+    if binario != por_defecto:
+        if not os.path.exists(binario):
+            sys.exit(f"Error crítico: no existe {binario}")
+        return
+    if subprocess.run(["make", objetivo]).returncode != 0:
+        sys.exit(f"Error crítico: 'make {objetivo}' falló.")
+
+
+def asegurar_instancia(generador, lado, semilla, escala):
+    """Devuelve la ruta relativa a instances/ del terreno de `lado` x `lado`."""
+    relativa = os.path.join(DIR_SINTETICAS, f"sint_{lado}_s{semilla}.sppb")
+    ruta = os.path.join(DIR_INSTANCIAS, relativa)
+    if not os.path.exists(ruta):
+        comando = [generador, ruta, str(lado), "--semilla", str(semilla)]
+        if escala > 0:
+            comando += ["--escala", str(escala)]
+        if subprocess.run(comando, stdout=subprocess.DEVNULL).returncode != 0:
+            sys.exit(f"Error crítico: no se pudo generar {ruta}")
+    return relativa
+
+
+def ejecutar(args, instancia, zonas, hilos):
+    """Corre el solver una vez y devuelve la fila del CSV (o None si falló)."""
+    restarts = args.restarts if args.restarts > 0 else hilos
+    with tempfile.TemporaryDirectory() as temporal:
+        archivo_stats = os.path.join(temporal, "stats.json")
+        comando = [args.solver, instancia, str(zonas), str(args.alpha), "--no-gui",
+                   "--seed", str(args.semilla), "--threads", str(hilos),
+                   "--restarts", str(restarts), "--stats", archivo_stats]
+        if args.time_limit > 0:
+            comando += ["--time-limit", str(args.time_limit)]
+        comando += shlex.split(args.extra)
+
+        inicio = time.perf_counter()
+        proceso = subprocess.run(comando, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+        tiempo_total = time.perf_counter() - inicio
+        if proceso.returncode != 0:
+            print(f"  Aviso: falló ({proceso.stderr.strip()})")
+            return None
+        with open(archivo_stats) as f:
+            stats = json.load(f)
+
+    busqueda = stats["tiempos"]["busqueda"]
+    evaluaciones = stats["contadores"]["movimientos_probados"]
+    return {
+        "Lado": stats["filas"],
+        "Celdas": stats["filas"] * stats["columnas"],
+        "Zonas": zonas,
+        "Hilos": hilos,
+        "Restarts": restarts,
+        "Alpha": args.alpha,
+        "Costo": stats["costo_final"],
+        "Tiempo_Lectura": stats["tiempos"]["lectura"],
+        "Tiempo_Busqueda": busqueda,
+        "Tiempo_Total": round(tiempo_total, 4),
+        "Evaluaciones": evaluaciones,
+        "Evaluaciones_Por_Segundo": round(evaluaciones / busqueda) if busqueda > 0 else 0,
+        "Memoria_Pico_MB": stats["memoria_pico_mb"],
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Barrido de escalamiento de spp_solver")
+    parser.add_argument("--lados", type=lista_enteros, default=[50, 100, 200, 500, 1000, 2000, 4000])
+    parser.add_argument("--zonas", type=lista_enteros, default=[4, 16])
+    parser.add_argument("--hilos", type=lista_enteros, default=[1, 2, 4])
+    parser.add_argument("--alpha", type=float, default=0.5)
+    parser.add_argument("--restarts", type=int, default=0, help="0 = uno por hilo")
+    parser.add_argument("--time-limit", type=float, default=120.0, help="Tope por ejecución (0 = sin tope)")
+    parser.add_argument("--semilla", type=int, default=1)
+    parser.add_argument("--escala", type=float, default=0.0, help="Largo de correlación (0 = lado / 4)")
+    parser.add_argument("--salida", default="data_csv/escalamiento.csv")
+    parser.add_argument("--extra", default="", help="Opciones adicionales para spp_solver")
+    parser.add_argument("--solver", default=SOLVER)
+    parser.add_argument("--generador", default=GENERADOR)
+    args = parser.parse_args()
+
+    compilar("all", args.solver, SOLVER)
+    compilar("generador", args.generador, GENERADOR)
+
+    os.makedirs(os.path.dirname(args.salida) or ".", exist_ok=True)
+    with open(args.salida, "w", newline="") as f:
+        escritor = csv.DictWriter(f, fieldnames=COLUMNAS)
+        escritor.writeheader()
+        for lado in args.lados:
+            instancia = asegurar_instancia(args.generador, lado, args.semilla, args.escala)
+            for zonas in args.zonas:
+                for hilos in args.hilos:
+                    print(f"Lado {lado}, zonas {zonas}, hilos {hilos}...", flush=True)
+                    fila = ejecutar(args, instancia, zonas, hilos)
+                    if fila is None:
+                        continue
+                    escritor.writerow(fila)
+                    f.flush()
+                    print(f"  {fila['Tiempo_Busqueda']:.3f} s, {fila['Evaluaciones_Por_Segundo']:,} evals/s, "
+                          f"{fila['Memoria_Pico_MB']:.1f} MB")
+
+    print(f"\nResultados en: {args.salida}")
+
+
+if __name__ == "__main__":
+    main()
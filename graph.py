@@ -1,4 +1,5 @@
 import os
+import sys
 import glob
 import re
 import pandas as pd
@@ -73,6 +74,21 @@ def read_experiment_data(folder_path="test_results"):
     print(f"Se procesaron correctamente {count_read} archivos.")
     return pd.DataFrame(data_records)
 
+def read_batch_csv(csv_path):
+    """
+    Lee el CSV por ejecución que escribe `spp_solver --batch`
+    (<salida>_ejecuciones.csv) y lo resume igual que read_experiment_data.
+    """
+    df_runs = pd.read_csv(csv_path)
+    print(f"Leídas {len(df_runs)} ejecuciones desde {csv_path}.")
+
+    grouped = df_runs.groupby(["Instancia", "Zonas", "Alpha"])
+    return pd.DataFrame({
+        "Costo_Promedio": grouped["Costo_Con"].mean(),
+        "Costo_Std": grouped["Costo_Con"].std(),
+        "Tiempo_Promedio": grouped["Tiempo"].mean(),
+    }).reset_index()
+
 def plot_by_instance(df):
     instancias = df["Instancia"].unique()
     
@@ -126,8 +142,60 @@ def plot_by_instance(df):
         print(f"  -> Guardado: {filename_out}")
         plt.close()
 
+def plot_escalamiento(csv_path):
+    """
+    Grafica el CSV de escalamiento.py: tiempo de búsqueda, evaluaciones por
+    segundo y pico de memoria contra el número de celdas (escala log-log),
+    una curva por cantidad de hilos y un estilo de línea por zonas.
+    """
+    df = pd.read_csv(csv_path).sort_values(by=["Celdas"])
+    print(f"Leídas {len(df)} ejecuciones desde {csv_path}.")
+    if df.empty:
+        print("No hay ejecuciones para graficar.")
+        return
+
+    paneles = [
+        ("Tiempo_Busqueda", "Tiempo de búsqueda (s)"),
+        ("Evaluaciones_Por_Segundo", "Evaluaciones por segundo"),
+        ("Memoria_Pico_MB", "Pico de memoria (MB)"),
+    ]
+    fig, axes = plt.subplots(1, 3, figsize=(20, 6))
+    for ax, (columna, etiqueta) in zip(axes, paneles):
+        sns.lineplot(
+            data=df,
+            x="Celdas",
+            y=columna,
+            hue="Hilos",
+            style="Zonas",
+            palette="viridis",
+            marker="o",
+            ax=ax
+        )
+        ax.set_xscale("log")
+        ax.set_yscale("log")
+        ax.set_title(f"{etiqueta} vs Celdas")
+        ax.set_ylabel(etiqueta)
+        ax.set_xlabel("Celdas (N x M)")
+
+    plt.tight_layout()
+    folder_out = "graficos"
+    os.makedirs(folder_out, exist_ok=True)
+    filename_out = os.path.join(folder_out, "escalamiento.png")
+    plt.savefig(filename_out)
+    print(f"  -> Guardado: {filename_out}")
+    plt.close()
+
 if __name__ == "__main__":
-    df_resultados = read_experiment_data()
+    # python graph.py [data_csv/<salida>_ejecuciones.csv]
+    # python graph.py --escalamiento data_csv/escalamiento.csv
+    if len(sys.argv) > 2 and sys.argv[1] == "--escalamiento":
+        plot_escalamiento(sys.argv[2])
+        sys.exit(0)
+
+    if len(sys.argv) > 1:
+        df_resultados = read_batch_csv(sys.argv[1])
+    else:
+        df_resultados = read_experiment_data()
     
     if not df_resultados.empty:
         plot_by_instance(df_resultados)
@@ -30,10 +30,10 @@ fi
 # ------------------
 
 echo "Compilando desde src/..."
-g++ src/main.cpp src/heatmap.cpp -I/usr/include/opencv4 -lopencv_core -lopencv_imgproc -lopencv_highgui -lopencv_imgcodecs -o spp_solver
+make
 
 if [ $? -ne 0 ]; then
-    echo "Error compilación. Verifica que main.cpp y heatmap.cpp estén en la carpeta src/"
+    echo "Error compilación. Verifica que las fuentes estén en la carpeta src/"
     exit 1
 fi
 
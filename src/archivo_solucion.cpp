@@ -0,0 +1,106 @@
+#include "archivo_solucion.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @struct CabeceraSppz
+ * @brief Cabecera de un archivo .sppz; le siguen filas * columnas zona_t por filas.
+ */
+struct CabeceraSppz {
+    char magia[4];          // "SPPZ"
+    std::uint32_t version;  // 1
+    std::uint32_t filas;
+    std::uint32_t columnas;
+    std::uint32_t zonas;
+    std::uint32_t reservado;
+    double alpha;
+    std::uint64_t semilla;
+    double costo;
+};
+static_assert(sizeof(CabeceraSppz) == 48, "La cabecera .sppz debe ocupar 48 bytes");
+
+constexpr std::uint32_t VERSION_SPPZ = 1;
+
+} // namespace
+
+void guardar_solucion(const std::string& ruta, const Solucion& solucion, int num_zonas, double alpha,
+                      std::uint64_t semilla) {
+    const Grid<zona_t>& zonas = solucion.zonas_asignadas;
+    std::string temporal = ruta + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(temporal, std::ios::binary);
+        if (!out.is_open()) {
+            throw std::runtime_error("No se pudo escribir el archivo: " + ruta);
+        }
+        CabeceraSppz cabecera{};
+        std::memcpy(cabecera.magia, "SPPZ", 4);
+        cabecera.version = VERSION_SPPZ;
+        cabecera.filas = static_cast<std::uint32_t>(zonas.filas());
+        cabecera.columnas = static_cast<std::uint32_t>(zonas.columnas());
+        cabecera.zonas = static_cast<std::uint32_t>(num_zonas);
+        cabecera.alpha = alpha;
+        cabecera.semilla = semilla;
+        cabecera.costo = solucion.costo;
+        out.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+        out.write(reinterpret_cast<const char*>(zonas.data()), zonas.size() * sizeof(zona_t));
+        if (!out) {
+            out.close();
+            std::remove(temporal.c_str());
+            throw std::runtime_error("Error escribiendo: " + ruta);
+        }
+    }
+    if (std::rename(temporal.c_str(), ruta.c_str()) != 0) {
+        std::remove(temporal.c_str());
+        throw std::runtime_error("No se pudo renombrar " + temporal + " a " + ruta);
+    }
+}
+
+SolucionGuardada cargar_solucion(const std::string& ruta) {
+    std::ifstream in(ruta, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        throw std::runtime_error("No se pudo abrir el archivo: " + ruta);
+    }
+    std::streamoff tamano = in.tellg();
+    in.seekg(0);
+
+    CabeceraSppz cabecera;
+    if (tamano < static_cast<std::streamoff>(sizeof(cabecera)) ||
+        !in.read(reinterpret_cast<char*>(&cabecera), sizeof(cabecera))) {
+        throw std::runtime_error("Archivo .sppz truncado: " + ruta);
+    }
+    if (std::memcmp(cabecera.magia, "SPPZ", 4) != 0 || cabecera.version != VERSION_SPPZ ||
+        cabecera.zonas < 1 || cabecera.zonas > static_cast<std::uint32_t>(MAX_ZONAS)) {
+        throw std::runtime_error("Cabecera .sppz inválida: " + ruta);
+    }
+    // Mismo control que leer_sppb: Grid indexa con int
+    const auto maximo = static_cast<std::uint32_t>(std::numeric_limits<int>::max());
+    if (cabecera.filas == 0 || cabecera.columnas == 0 || cabecera.filas > maximo || cabecera.columnas > maximo) {
+        throw std::runtime_error("Dimensiones de .sppz inválidas: " + ruta);
+    }
+    std::size_t celdas = static_cast<std::size_t>(cabecera.filas) * cabecera.columnas;
+    if (static_cast<std::size_t>(tamano) != sizeof(cabecera) + celdas * sizeof(zona_t)) {
+        throw std::runtime_error("Tamaño de .sppz inconsistente: " + ruta);
+    }
+
+    SolucionGuardada guardada{Solucion(static_cast<int>(cabecera.filas), static_cast<int>(cabecera.columnas)),
+                              static_cast<int>(cabecera.zonas), cabecera.alpha, cabecera.semilla};
+    Grid<zona_t>& zonas = guardada.solucion.zonas_asignadas;
+    if (!in.read(reinterpret_cast<char*>(zonas.data()), celdas * sizeof(zona_t))) {
+        throw std::runtime_error("Error leyendo: " + ruta);
+    }
+    for (zona_t zona : zonas) {
+        if (zona >= cabecera.zonas) {
+            throw std::runtime_error("Etiqueta de zona fuera de rango en " + ruta + ": " + std::to_string(zona));
+        }
+    }
+    guardada.solucion.costo = cabecera.costo;
+    return guardada;
+}
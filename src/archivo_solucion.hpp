@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "spp.hpp"
+
+/**
+ * @struct SolucionGuardada
+ * @brief Una zonificación leída de un archivo .sppz, con los parámetros con
+ * que se obtuvo.
+ *
+ * @var solucion Zonas y costo al momento de guardarla (el costo puede no
+ * corresponder al terreno actual si este cambió desde entonces).
+ * @var num_zonas p con que se resolvió.
+ * @var alpha Alpha con que se resolvió.
+ * @var semilla Semilla maestra de esa ejecución.
+ */
+struct SolucionGuardada {
+    Solucion solucion;
+    int num_zonas;
+    double alpha;
+    std::uint64_t semilla;
+};
+
+/**
+ * @brief Guarda una solución en formato binario .sppz: una cabecera de 48
+ * bytes ("SPPZ", versión, filas, columnas, p, alpha, semilla, costo)
+ * seguida de las etiquetas `zona_t` por filas. Como `escribir_sppb`, escribe
+ * a un temporal y lo renombra.
+ */
+void guardar_solucion(const std::string& ruta, const Solucion& solucion, int num_zonas, double alpha,
+                      std::uint64_t semilla);
+
+/**
+ * @brief Lee un archivo .sppz. Lanza std::runtime_error si la cabecera no es
+ * válida, el tamaño no coincide o alguna etiqueta no es menor que p.
+ */
+SolucionGuardada cargar_solucion(const std::string& ruta);
@@ -0,0 +1,208 @@
+#include "barrido.hpp"
+#include "varianza.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+// Costo de una zona con varianza `v`, como en evaluar_solucion (sin islas)
+double costo_varianza(double v, double umbral_varianza) {
+    return v + std::max(0.0, v - umbral_varianza) * PENALIZACION_HOMOGENEIDAD;
+}
+
+/**
+ * @brief Momentos por zona de cada banda: `m[b * num_zonas + zona]`.
+ */
+std::vector<MomentosVarianza> momentos_por_banda(const Instancia& instancia, const Grid<zona_t>& zonas, int num_zonas) {
+    std::vector<MomentosVarianza> m(static_cast<std::size_t>(instancia.num_bandas()) * num_zonas);
+    for (int b = 0; b < instancia.num_bandas(); ++b) {
+        momentos_por_zona(instancia.banda(b), zonas, num_zonas, m.data() + static_cast<std::size_t>(b) * num_zonas);
+    }
+    return m;
+}
+
+// Varianza ponderada entre bandas de la zona k (o de la unión de k y otra), como evaluar_solucion
+double varianza_ponderada(const Instancia& instancia, const std::vector<MomentosVarianza>& m, int num_zonas, int k,
+                          int otra = -1) {
+    double total = 0.0;
+    for (int b = 0; b < instancia.num_bandas(); ++b) {
+        MomentosVarianza zona = m[static_cast<std::size_t>(b) * num_zonas + k];
+        if (otra >= 0) zona.combinar(m[static_cast<std::size_t>(b) * num_zonas + otra]);
+        total += instancia.pesos[b] * zona.varianza();
+    }
+    return total;
+}
+
+} // namespace
+
+bool dividir_zona(const Instancia& instancia, Solucion& solucion, int num_zonas) {
+    Grid<zona_t>& zonas = solucion.zonas_asignadas;
+    const int N = instancia.N_filas;
+    const int M = instancia.M_columnas;
+    const int B = instancia.num_bandas();
+
+    std::vector<MomentosVarianza> por_zona = momentos_por_banda(instancia, zonas, num_zonas);
+
+    int zona = -1;
+    double varianza_zona = 0.0;
+    for (int k = 0; k < num_zonas; ++k) {
+        if (por_zona[k].n < 2) continue;
+        double v = varianza_ponderada(instancia, por_zona, num_zonas, k);
+        if (zona < 0 || v > varianza_zona) {
+            zona = k;
+            varianza_zona = v;
+        }
+    }
+    if (zona < 0) return false;
+
+    // Valor de una celda para elegir semillas: la suma ponderada de sus bandas
+    auto valor = [&](int idx) {
+        double total = 0.0;
+        for (int b = 0; b < B; ++b) total += instancia.pesos[b] * instancia.banda(b)[idx];
+        return total;
+    };
+
+    // Semillas: la celda de menor y la de mayor valor de la zona (si todos
+    // los valores son iguales, la primera y la última celda)
+    int semilla_min = -1, semilla_max = -1;
+    double valor_min = 0.0, valor_max = 0.0;
+    for (int idx = 0; idx < N * M; ++idx) {
+        if (zonas[idx] != zona) continue;
+        double v = valor(idx);
+        if (semilla_min < 0 || v < valor_min) {
+            semilla_min = idx;
+            valor_min = v;
+        }
+        if (semilla_max < 0 || v >= valor_max) {
+            semilla_max = idx;
+            valor_max = v;
+        }
+    }
+
+    const zona_t nueva = static_cast<zona_t>(num_zonas);
+    const zona_t etiqueta[2] = {static_cast<zona_t>(zona), nueva};
+    const int semilla[2] = {semilla_min, semilla_max};
+
+    // Diferencia con la semilla: suma ponderada de las diferencias por banda
+    auto diferencia = [&](int idx, int lado) {
+        double total = 0.0;
+        for (int b = 0; b < B; ++b) {
+            const Grid<float>& datos = instancia.banda(b);
+            total += instancia.pesos[b] * std::fabs(static_cast<double>(datos[idx]) - datos[semilla[lado]]);
+        }
+        return static_cast<float>(total);
+    };
+
+    // Crecimiento por prioridad: (diferencia con la semilla, celda, mitad)
+    using Candidato = std::tuple<float, int, int>;
+    std::priority_queue<Candidato, std::vector<Candidato>, std::greater<Candidato>> cola;
+    std::vector<std::int8_t> mitad(static_cast<std::size_t>(N) * M, -1);
+
+    int dr[] = {-1, 1, 0, 0};
+    int dc[] = {0, 0, -1, 1};
+    auto asignar = [&](int idx, int lado) {
+        mitad[idx] = static_cast<std::int8_t>(lado);
+        zonas[idx] = etiqueta[lado];
+        int i = idx / M, j = idx % M;
+        for (int d = 0; d < 4; ++d) {
+            int ni = i + dr[d], nj = j + dc[d];
+            if (ni < 0 || ni >= N || nj < 0 || nj >= M) continue;
+            int vecino = ni * M + nj;
+            if (zonas[vecino] != zona || mitad[vecino] >= 0) continue;
+            cola.emplace(diferencia(vecino, lado), vecino, lado);
+        }
+    };
+
+    asignar(semilla_min, 0);
+    asignar(semilla_max, 1);
+    while (!cola.empty()) {
+        auto [prioridad, idx, lado] = cola.top();
+        cola.pop();
+        (void)prioridad;
+        if (mitad[idx] >= 0) continue;
+        asignar(idx, lado);
+    }
+    // Las celdas de otras componentes de la zona (si no era conexa) se quedan en ella
+    return true;
+}
+
+bool fusionar_zonas(const Instancia& instancia, Solucion& solucion, int num_zonas, double umbral_varianza) {
+    Grid<zona_t>& zonas = solucion.zonas_asignadas;
+    const int N = instancia.N_filas;
+    const int M = instancia.M_columnas;
+
+    std::vector<MomentosVarianza> por_zona = momentos_por_banda(instancia, zonas, num_zonas);
+
+    // Una zona vacía se elimina sin tocar las demás
+    const zona_t ultima = static_cast<zona_t>(num_zonas - 1);
+    for (int k = 0; k < num_zonas; ++k) {
+        if (por_zona[k].n > 0) continue;
+        if (k != ultima) std::replace(zonas.begin(), zonas.end(), ultima, static_cast<zona_t>(k));
+        return true;
+    }
+
+    // Pares (a < b) de zonas adyacentes, codificados como a * num_zonas + b
+    std::vector<std::int64_t> pares;
+    auto agregar_par = [&](zona_t x, zona_t y) {
+        if (x == y) return;
+        std::int64_t a = std::min(x, y), b = std::max(x, y);
+        pares.push_back(a * num_zonas + b);
+    };
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < M; ++j) {
+            if (j + 1 < M) agregar_par(zonas(i, j), zonas(i, j + 1));
+            if (i + 1 < N) agregar_par(zonas(i, j), zonas(i + 1, j));
+        }
+    }
+    std::sort(pares.begin(), pares.end());
+    pares.erase(std::unique(pares.begin(), pares.end()), pares.end());
+    if (pares.empty()) return false;
+
+    int mejor_a = -1, mejor_b = -1;
+    double mejor_aumento = 0.0;
+    for (std::int64_t par : pares) {
+        int a = static_cast<int>(par / num_zonas);
+        int b = static_cast<int>(par % num_zonas);
+        double aumento = costo_varianza(varianza_ponderada(instancia, por_zona, num_zonas, a, b), umbral_varianza) -
+                         costo_varianza(varianza_ponderada(instancia, por_zona, num_zonas, a), umbral_varianza) -
+                         costo_varianza(varianza_ponderada(instancia, por_zona, num_zonas, b), umbral_varianza);
+        if (mejor_a < 0 || aumento < mejor_aumento) {
+            mejor_a = a;
+            mejor_b = b;
+            mejor_aumento = aumento;
+        }
+    }
+
+    // b se une a a; la última etiqueta ocupa el lugar de b
+    for (zona_t& z : zonas) {
+        if (z == mejor_b) z = static_cast<zona_t>(mejor_a);
+        else if (z == ultima) z = static_cast<zona_t>(mejor_b);
+    }
+    return true;
+}
+
+void ajustar_num_zonas(const Instancia& instancia, Solucion& solucion, int zonas_origen, double umbral_varianza) {
+    int zonas = zonas_origen;
+    while (zonas < instancia.num_zonas) {
+        if (!dividir_zona(instancia, solucion, zonas)) {
+            throw std::runtime_error("No se puede pasar a " + std::to_string(instancia.num_zonas) +
+                                     " zonas: no quedan zonas divisibles");
+        }
+        ++zonas;
+    }
+    while (zonas > instancia.num_zonas) {
+        if (!fusionar_zonas(instancia, solucion, zonas, umbral_varianza)) {
+            throw std::runtime_error("No se puede pasar a " + std::to_string(instancia.num_zonas) +
+                                     " zonas: no quedan zonas adyacentes");
+        }
+        --zonas;
+    }
+    solucion.costo = evaluar_solucion(instancia, solucion, umbral_varianza);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "spp.hpp"
+
+/**
+ * @brief Divide en dos la zona de mayor varianza de `solucion`; la nueva
+ * zona recibe la etiqueta `num_zonas`.
+ *
+ * Las dos mitades crecen desde las celdas de valor mínimo y máximo de la
+ * zona, cada una absorbiendo primero al vecino de valor más parecido a su
+ * semilla. Con varias bandas, la varianza es la ponderada de `evaluar_solucion`,
+ * el valor de una celda es la suma ponderada de sus bandas y el parecido, la
+ * suma ponderada de las diferencias por banda. Cada mitad es conexa (crece por adyacencia), así que una zona
+ * conexa da dos zonas conexas.
+ *
+ * @return false si ninguna zona tiene al menos dos celdas.
+ */
+bool dividir_zona(const Instancia& instancia, Solucion& solucion, int num_zonas);
+
+/**
+ * @brief Fusiona el par de zonas adyacentes cuya unión menos aumenta el costo
+ * (varianza ponderada entre bandas más penalización sobre `umbral_varianza`).
+ * La zona fusionada toma la etiqueta menor y la zona `num_zonas - 1` pasa a
+ * ocupar la que queda libre, de modo que las etiquetas siguen siendo
+ * 0..num_zonas-2.
+ *
+ * @return false si no hay dos zonas adyacentes.
+ */
+bool fusionar_zonas(const Instancia& instancia, Solucion& solucion, int num_zonas, double umbral_varianza);
+
+/**
+ * @brief Lleva `solucion`, una zonificación con `zonas_origen` zonas, a
+ * `instancia.num_zonas` zonas dividiendo o fusionando de a una. Sirve para
+ * arrancar en caliente el problema con p vecino sin empezar de cero.
+ * Deja `solucion.costo` evaluado en `instancia` con `umbral_varianza`.
+ */
+void ajustar_num_zonas(const Instancia& instancia, Solucion& solucion, int zonas_origen, double umbral_varianza);
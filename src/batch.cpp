@@ -0,0 +1,521 @@
+#include "batch.hpp"
+#include "barrido.hpp"
+#include "estadisticas.hpp"
+#include "evaluacion_incremental.hpp"
+#include "inicializacion.hpp"
+#include "motores.hpp"
+#include "varianza.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct ConfiguracionBatch {
+    std::vector<std::string> instancias;  // "a.spp+b.spp" = a.spp con b.spp como banda 1
+    std::vector<double> pesos;            // Peso de cada banda (vacío = 1 para todas)
+    std::vector<int> zonas;
+    std::vector<double> alphas;
+    int repeticiones = 10;
+    int restarts = 20;
+    std::string salida = "data_csv/batch";
+    std::string imagenes; // Directorio para los mapas de calor ("" = no se generan)
+    bool barrido = false;  // modo barrido: cadenas en caliente en vez de ejecuciones independientes
+    int restarts_caliente = 2;
+};
+
+struct Tarea {
+    int instancia;
+    int zonas;
+    double alpha;
+    int repeticion;
+};
+
+struct ResultadoEjecucion {
+    std::uint64_t semilla = 0;
+    double costo_sin = 0.0;
+    double costo_con = 0.0;
+    double tiempo = 0.0;
+    bool homogenea = false;          // Toda zona bajo el umbral
+    bool factible = false;           // Homogénea y sin islas
+    const char* arranque = "frio";   // frio, alpha, division, fusion, envolvente o error
+    bool completada = false;
+    std::string error;               // Mensaje si la ejecución lanzó una excepción
+};
+
+ConfiguracionBatch leer_jobs(const std::string& archivo_jobs) {
+    std::ifstream file(archivo_jobs);
+    if (!file.is_open()) {
+        throw std::runtime_error("No se pudo abrir el archivo: " + archivo_jobs);
+    }
+
+    ConfiguracionBatch config;
+    std::string linea;
+    while (std::getline(file, linea)) {
+        std::size_t comentario = linea.find('#');
+        if (comentario != std::string::npos) linea.erase(comentario);
+
+        std::istringstream ss(linea);
+        std::string clave;
+        if (!(ss >> clave)) continue;
+
+        if (clave == "instancias") {
+            std::string valor;
+            while (ss >> valor) config.instancias.push_back(valor);
+        } else if (clave == "pesos") {
+            double valor;
+            while (ss >> valor) config.pesos.push_back(valor);
+        } else if (clave == "zonas") {
+            int valor;
+            while (ss >> valor) config.zonas.push_back(valor);
+        } else if (clave == "alphas") {
+            double valor;
+            while (ss >> valor) config.alphas.push_back(valor);
+        } else if (clave == "repeticiones") {
+            ss >> config.repeticiones;
+        } else if (clave == "restarts") {
+            ss >> config.restarts;
+        } else if (clave == "salida") {
+            ss >> config.salida;
+        } else if (clave == "imagenes") {
+            ss >> config.imagenes;
+        } else if (clave == "modo") {
+            std::string modo;
+            ss >> modo;
+            if (modo != "grilla" && modo != "barrido") {
+                throw std::runtime_error("Modo desconocido en " + archivo_jobs + ": " + modo + " (grilla|barrido)");
+            }
+            config.barrido = (modo == "barrido");
+        } else if (clave == "restarts_caliente") {
+            ss >> config.restarts_caliente;
+        } else {
+            throw std::runtime_error("Clave desconocida en " + archivo_jobs + ": " + clave);
+        }
+    }
+
+    if (config.instancias.empty() || config.zonas.empty() || config.alphas.empty()) {
+        throw std::runtime_error(archivo_jobs + " debe definir 'instancias', 'zonas' y 'alphas'");
+    }
+    if (config.repeticiones < 1 || config.restarts < 1 || config.restarts_caliente < 1) {
+        throw std::runtime_error("'repeticiones', 'restarts' y 'restarts_caliente' deben ser al menos 1");
+    }
+    for (int z : config.zonas) {
+        if (z < 1 || z > MAX_ZONAS) {
+            throw std::runtime_error("num_zonas debe estar entre 1 y " + std::to_string(MAX_ZONAS));
+        }
+    }
+    return config;
+}
+
+// Rutas de las bandas de una instancia: "a.spp+b.spp" -> {a.spp, b.spp}
+std::vector<std::string> rutas_bandas(const std::string& instancia) {
+    std::vector<std::string> rutas;
+    std::istringstream ss(instancia);
+    std::string ruta;
+    while (std::getline(ss, ruta, '+')) rutas.push_back(ruta);
+    return rutas;
+}
+
+// Nombre corto de la instancia (ej. "mediana_1.spp", el de la banda 0), como lo usa graph.py
+std::string nombre_instancia(const std::string& ruta) {
+    return std::filesystem::path(rutas_bandas(ruta).front()).filename().string();
+}
+
+std::ofstream abrir_csv(const std::string& ruta) {
+    std::filesystem::path padre = std::filesystem::path(ruta).parent_path();
+    if (!padre.empty()) std::filesystem::create_directories(padre);
+
+    std::ofstream out(ruta);
+    if (!out.is_open()) {
+        throw std::runtime_error("No se pudo escribir el archivo: " + ruta);
+    }
+    out << std::setprecision(10);
+    return out;
+}
+
+} // namespace
+
+int ejecutar_batch(const std::string& archivo_jobs, const OpcionesBusqueda& opciones) {
+    ConfiguracionBatch config = leer_jobs(archivo_jobs);
+
+    // Cada instancia (con todas sus bandas) se lee del disco una sola vez
+    std::vector<std::vector<std::shared_ptr<Grid<float>>>> datos;
+    std::vector<double> tiempo_lectura;
+    for (const std::string& instancia : config.instancias) {
+        auto inicio_lectura = std::chrono::high_resolution_clock::now();
+        datos.emplace_back();
+        for (const std::string& ruta : rutas_bandas(instancia)) {
+            datos.back().push_back(std::make_shared<Grid<float>>(leer_datos("instances/" + ruta, opciones.usar_cache)));
+        }
+        tiempo_lectura.push_back(
+            std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - inicio_lectura).count());
+        if (datos.back().size() > 1 &&
+            (opciones.multinivel || opciones.estrategia != EstrategiaBusqueda::FIRST_IMPROVEMENT)) {
+            throw std::runtime_error("Con varias bandas (" + instancia +
+                                     ") solo se admite --estrategia first (sin --multinivel)");
+        }
+    }
+
+    // Las instancias de cada p son vistas sobre los mismos rasters (copiar la
+    // Grid duplicaría el mapa por cada p y sacaría a un .sppb de su mmap)
+    std::vector<std::vector<Instancia>> instancias(config.instancias.size());
+    for (std::size_t k = 0; k < datos.size(); ++k) {
+        std::vector<double> pesos = config.pesos;
+        if (pesos.empty()) pesos.assign(datos[k].size(), 1.0);
+        instancias[k].reserve(config.zonas.size());
+        for (int z : config.zonas) {
+            std::vector<Grid<float>> bandas;
+            for (const std::shared_ptr<Grid<float>>& raster : datos[k]) {
+                bandas.push_back(Grid<float>::vista(raster->filas(), raster->columnas(), raster->data(), raster));
+            }
+            instancias[k].emplace_back(std::move(bandas), pesos, z);
+        }
+    }
+
+    // Var(S) (ponderada entre bandas) no depende de p ni de alpha
+    std::vector<double> varianza_total;
+    for (const std::vector<Instancia>& por_zonas : instancias) {
+        varianza_total.push_back(calcular_varianza_total(por_zonas.front()));
+    }
+
+    std::vector<Tarea> tareas;
+    for (std::size_t k = 0; k < config.instancias.size(); ++k) {
+        for (std::size_t iz = 0; iz < config.zonas.size(); ++iz) {
+            for (double alpha : config.alphas) {
+                for (int rep = 0; rep < config.repeticiones; ++rep) {
+                    tareas.push_back({static_cast<int>(k), static_cast<int>(iz), alpha, rep});
+                }
+            }
+        }
+    }
+
+    if (config.barrido && opciones.multinivel) {
+        throw std::runtime_error("El modo barrido no es compatible con --multinivel (no admite arranque en caliente)");
+    }
+
+    // En modo barrido cada (instancia, repetición) es una cadena secuencial
+    std::size_t num_cadenas = config.instancias.size() * config.repeticiones;
+    std::size_t num_trabajos = config.barrido ? num_cadenas : tareas.size();
+    int num_hilos = std::max(1, std::min<int>(opciones.num_hilos, static_cast<int>(num_trabajos)));
+
+    if (config.barrido) {
+        std::cout << "Barrido: " << num_cadenas << " cadenas de " << config.zonas.size() * config.alphas.size()
+                  << " puntos en " << num_hilos << " hilos" << std::endl;
+    } else {
+        std::cout << "Batch: " << tareas.size() << " ejecuciones en " << num_hilos << " hilos" << std::endl;
+    }
+    std::cout << "Semilla: " << opciones.semilla << std::endl;
+    auto inicio_batch = std::chrono::high_resolution_clock::now();
+
+    std::vector<ResultadoEjecucion> resultados(tareas.size());
+
+    // Con 'imagenes', la mejor solución de cada configuración (ante empate, la
+    // de menor repetición, para que no dependa del orden de los hilos)
+    bool con_imagenes = !config.imagenes.empty();
+    std::size_t num_grupos = con_imagenes ? tareas.size() / config.repeticiones : 0;
+    std::vector<Solucion> mejor_grupo(num_grupos, Solucion(0, 0));
+    std::vector<int> repeticion_grupo(num_grupos, -1);
+
+    bool con_estadisticas = !opciones.archivo_estadisticas.empty();
+    std::vector<EstadisticasEjecucion> estadisticas(con_estadisticas ? tareas.size() : 0);
+    std::atomic<std::size_t> siguiente{0};
+    std::atomic<std::size_t> terminadas{0};
+    std::mutex mutex_salida;
+
+    // Llamar con mutex_salida tomado
+    auto registrar_imagen = [&](std::size_t t, const Solucion& solucion) {
+        if (!con_imagenes) return;
+        std::size_t g = t / config.repeticiones;
+        int repeticion = tareas[t].repeticion;
+        if (repeticion_grupo[g] < 0 || solucion.costo < mejor_grupo[g].costo ||
+            (solucion.costo == mejor_grupo[g].costo && repeticion < repeticion_grupo[g])) {
+            mejor_grupo[g] = solucion;
+            repeticion_grupo[g] = repeticion;
+        }
+    };
+
+    // Resuelve la tarea t; con `partida` arranca el restart 0 desde ella
+    auto ejecutar_tarea = [&](std::size_t t, int num_restarts, const Solucion* partida, const char* arranque,
+                              double tiempo_previo) {
+        const Tarea& tarea = tareas[t];
+        const Instancia& instancia = instancias[tarea.instancia][tarea.zonas];
+
+        OpcionesBusqueda opciones_ejecucion = opciones;
+        // Cada ejecución es secuencial: el paralelismo está entre ejecuciones
+        // (en barrido, los hilos que sobran tras repartir las cadenas van a los restarts)
+        opciones_ejecucion.num_hilos = config.barrido ? std::max(1, opciones.num_hilos / num_hilos) : 1;
+        opciones_ejecucion.num_restarts = num_restarts;
+        opciones_ejecucion.solucion_inicial = partida;
+        opciones_ejecucion.archivo_traza.clear(); // Una traza por ejecución se pisaría entre hilos
+        opciones_ejecucion.reportar_mejoras = false;
+        opciones_ejecucion.semilla = derivar_semilla(opciones.semilla, t);
+
+        double umbral = tarea.alpha * varianza_total[tarea.instancia];
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        EstadisticasEjecucion* e = con_estadisticas ? &estadisticas[t] : nullptr;
+        Solucion solucion = resolver_con_restart(instancia, umbral, opciones_ejecucion, e);
+        auto fin = std::chrono::high_resolution_clock::now();
+
+        ResultadoEjecucion& r = resultados[t];
+        r.semilla = opciones_ejecucion.semilla;
+        r.costo_sin = evaluar_solucion(instancia, solucion, std::numeric_limits<double>::infinity());
+        r.costo_con = solucion.costo;
+        r.tiempo = tiempo_previo + std::chrono::duration<double>(fin - inicio).count();
+        r.arranque = arranque;
+        r.homogenea = evaluar_solucion(instancia, solucion, umbral) == r.costo_sin;
+        r.factible = r.homogenea && EstadoEvaluacion(instancia, solucion, umbral).islas() == 0;
+        r.completada = true;
+
+        if (e) {
+            e->instancia = config.instancias[tarea.instancia];
+            e->filas = instancia.N_filas;
+            e->columnas = instancia.M_columnas;
+            e->zonas = instancia.num_zonas;
+            e->alpha = tarea.alpha;
+            e->semilla = opciones_ejecucion.semilla;
+            e->hilos = opciones_ejecucion.num_hilos;
+            e->estrategia = nombre_estrategia(opciones.estrategia);
+            e->inicial = nombre_metodo_inicial(opciones.inicial);
+            e->motor = nombre_motor(opciones.motor);
+            e->tiempo_lectura = tiempo_lectura[tarea.instancia]; // Compartido por todas sus ejecuciones
+            e->costo_final = solucion.costo;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_salida);
+        registrar_imagen(t, solucion);
+        std::cout << "[" << ++terminadas << "/" << tareas.size() << "] "
+                  << config.instancias[tarea.instancia] << " z" << config.zonas[tarea.zonas]
+                  << " a" << tarea.alpha << " rep " << (tarea.repeticion + 1)
+                  << ": " << r.costo_con << " (" << r.tiempo << " s";
+        if (config.barrido) std::cout << ", " << arranque;
+        std::cout << ")" << std::endl;
+        return solucion;
+    };
+
+    // Índice de (instancia, zonas, alpha, repetición) en `tareas`
+    auto indice_tarea = [&](std::size_t k, std::size_t iz, std::size_t ia, int rep) {
+        return ((k * config.zonas.size() + iz) * config.alphas.size() + ia) * config.repeticiones + rep;
+    };
+
+    // Alphas de la más holgada a la más estricta: cada umbral parte del óptimo del anterior
+    std::vector<std::size_t> orden_alphas(config.alphas.size());
+    std::iota(orden_alphas.begin(), orden_alphas.end(), 0);
+    std::stable_sort(orden_alphas.begin(), orden_alphas.end(),
+                     [&](std::size_t a, std::size_t b) { return config.alphas[a] > config.alphas[b]; });
+
+    // Cadena de una (instancia, repetición): el primer punto en frío, el resto en
+    // caliente. Al cambiar de p se parte de la solución con el alpha más holgado
+    // del p anterior, dividiendo o fusionando zonas (ver barrido.hpp).
+    auto ejecutar_cadena = [&](std::size_t c) {
+        std::size_t k = c / config.repeticiones;
+        int rep = static_cast<int>(c % config.repeticiones);
+
+        Solucion anterior_p(0, 0), anterior_alpha(0, 0);
+        std::vector<Solucion> por_alpha(orden_alphas.size(), Solucion(0, 0));
+        int zonas_anterior = 0;
+        for (std::size_t iz = 0; iz < config.zonas.size(); ++iz) {
+            for (std::size_t pos = 0; pos < orden_alphas.size(); ++pos) {
+                std::size_t t = indice_tarea(k, iz, orden_alphas[pos], rep);
+                if (iz == 0 && pos == 0) {
+                    anterior_alpha = ejecutar_tarea(t, config.restarts, nullptr, "frio", 0.0);
+                } else if (pos == 0) {
+                    const Instancia& instancia = instancias[k][iz];
+                    const char* arranque = instancia.num_zonas > zonas_anterior ? "division"
+                                           : instancia.num_zonas < zonas_anterior ? "fusion" : "alpha";
+                    auto inicio = std::chrono::high_resolution_clock::now();
+                    Solucion partida = std::move(anterior_p);
+                    ajustar_num_zonas(instancia, partida, zonas_anterior, tareas[t].alpha * varianza_total[k]);
+                    double tiempo_ajuste = std::chrono::duration<double>(
+                        std::chrono::high_resolution_clock::now() - inicio).count();
+                    anterior_alpha = ejecutar_tarea(t, config.restarts_caliente, &partida, arranque, tiempo_ajuste);
+                } else {
+                    anterior_alpha = ejecutar_tarea(t, config.restarts_caliente, &anterior_alpha, "alpha", 0.0);
+                }
+                por_alpha[pos] = anterior_alpha;
+            }
+
+            // Envolvente: una solución homogénea con un alpha estricto lo es
+            // también con los más holgados, con el mismo costo. Se recorre de
+            // estricto a holgado y cada punto adopta la mejor ya vista si es menor.
+            int mejor = -1;
+            for (int pos = static_cast<int>(orden_alphas.size()) - 1; pos >= 0; --pos) {
+                std::size_t t = indice_tarea(k, iz, orden_alphas[pos], rep);
+                ResultadoEjecucion& r = resultados[t];
+                if (mejor >= 0 && por_alpha[mejor].costo < r.costo_con) {
+                    const ResultadoEjecucion& origen = resultados[indice_tarea(k, iz, orden_alphas[mejor], rep)];
+                    por_alpha[pos] = por_alpha[mejor];
+                    r.costo_sin = r.costo_con = por_alpha[pos].costo;
+                    r.homogenea = true;
+                    r.factible = origen.factible;
+                    r.arranque = "envolvente";
+                    if (con_estadisticas) estadisticas[t].costo_final = por_alpha[pos].costo;
+                    std::lock_guard<std::mutex> lock(mutex_salida);
+                    registrar_imagen(t, por_alpha[pos]);
+                } else if (r.homogenea && (mejor < 0 || r.costo_con < por_alpha[mejor].costo)) {
+                    mejor = pos;
+                }
+            }
+
+            anterior_p = por_alpha[0];
+            zonas_anterior = config.zonas[iz];
+        }
+    };
+
+    // Una excepción no puede salir de un std::thread (terminaría el batch
+    // entero): la ejecución queda marcada con el error en el CSV y el resto
+    // del batch sigue. En una cadena se marcan los puntos que no alcanzaron a
+    // terminar; los anteriores conservan su resultado
+    std::atomic<std::size_t> fallidas{0};
+    auto registrar_fallo = [&](std::size_t trabajo, const std::string& mensaje) {
+        std::vector<std::size_t> afectadas;
+        if (config.barrido) {
+            std::size_t k = trabajo / config.repeticiones;
+            int rep = static_cast<int>(trabajo % config.repeticiones);
+            for (std::size_t iz = 0; iz < config.zonas.size(); ++iz) {
+                for (std::size_t ia = 0; ia < config.alphas.size(); ++ia) {
+                    afectadas.push_back(indice_tarea(k, iz, ia, rep));
+                }
+            }
+        } else {
+            afectadas.push_back(trabajo);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_salida);
+        for (std::size_t t : afectadas) {
+            ResultadoEjecucion& r = resultados[t];
+            if (r.completada) continue;
+            r.error = mensaje;
+            r.arranque = "error";
+            ++fallidas;
+        }
+        const Tarea& tarea = tareas[afectadas.front()];
+        std::cerr << (config.barrido ? "Cadena " : "Ejecucion ") << config.instancias[tarea.instancia];
+        if (!config.barrido) std::cerr << " z" << config.zonas[tarea.zonas] << " a" << tarea.alpha;
+        std::cerr << " rep " << (tarea.repeticion + 1) << ": Error: " << mensaje << std::endl;
+    };
+
+    auto worker = [&]() {
+        for (std::size_t t = siguiente++; t < num_trabajos; t = siguiente++) {
+            try {
+                if (config.barrido) {
+                    ejecutar_cadena(t);
+                } else {
+                    ejecutar_tarea(t, config.restarts, nullptr, "frio", 0.0);
+                }
+            } catch (const std::exception& e) {
+                registrar_fallo(t, e.what());
+            } catch (...) {
+                registrar_fallo(t, "error desconocido");
+            }
+        }
+    };
+
+    std::vector<std::thread> hilos;
+    for (int h = 0; h < num_hilos; ++h) hilos.emplace_back(worker);
+    for (auto& h : hilos) h.join();
+    std::cout << "Tiempo total: "
+              << std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - inicio_batch).count()
+              << " s" << std::endl;
+
+    // Una fila por ejecución
+    std::string ruta_ejecuciones = config.salida + "_ejecuciones.csv";
+    std::ofstream ejecuciones = abrir_csv(ruta_ejecuciones);
+    ejecuciones << "Instancia,Zonas,Alpha,Repeticion,Semilla,Costo_Sin,Costo_Con,Tiempo,Factible,Arranque\n";
+    for (std::size_t t = 0; t < tareas.size(); ++t) {
+        const Tarea& tarea = tareas[t];
+        const ResultadoEjecucion& r = resultados[t];
+        ejecuciones << nombre_instancia(config.instancias[tarea.instancia]) << ","
+                    << config.zonas[tarea.zonas] << "," << tarea.alpha << "," << (tarea.repeticion + 1) << ",";
+        if (!r.error.empty()) {
+            // Sin costos ni tiempo: la ejecución no terminó
+            ejecuciones << derivar_semilla(opciones.semilla, t) << ",,,,0," << r.arranque << "\n";
+            continue;
+        }
+        ejecuciones << r.semilla << "," << r.costo_sin << "," << r.costo_con << "," << r.tiempo << ","
+                    << (r.factible ? 1 : 0) << "," << r.arranque << "\n";
+    }
+
+    // Resumen por configuración (promedio y desviación estándar muestral, como pandas)
+    std::string ruta_resumen = config.salida + "_resumen.csv";
+    std::ofstream resumen = abrir_csv(ruta_resumen);
+    resumen << "Instancia,Zonas,Alpha,Costo_Promedio,Costo_Std,Tiempo_Promedio\n";
+    for (std::size_t t = 0; t < tareas.size(); t += config.repeticiones) {
+        const Tarea& tarea = tareas[t];
+
+        // Solo las repeticiones que terminaron
+        int n = 0;
+        double suma_costo = 0.0, suma_tiempo = 0.0;
+        for (int rep = 0; rep < config.repeticiones; ++rep) {
+            if (!resultados[t + rep].error.empty()) continue;
+            ++n;
+            suma_costo += resultados[t + rep].costo_con;
+            suma_tiempo += resultados[t + rep].tiempo;
+        }
+        resumen << nombre_instancia(config.instancias[tarea.instancia]) << ","
+                << config.zonas[tarea.zonas] << "," << tarea.alpha << ",";
+        if (n == 0) {
+            resumen << ",,\n";
+            continue;
+        }
+        double media = suma_costo / n;
+        double suma_dif = 0.0;
+        for (int rep = 0; rep < config.repeticiones; ++rep) {
+            if (!resultados[t + rep].error.empty()) continue;
+            double dif = resultados[t + rep].costo_con - media;
+            suma_dif += dif * dif;
+        }
+
+        resumen << media << ",";
+        if (n > 1) resumen << std::sqrt(suma_dif / (n - 1));
+        resumen << "," << suma_tiempo / n << "\n";
+    }
+
+    std::cout << "Resultados en: " << ruta_ejecuciones << " y " << ruta_resumen << std::endl;
+
+    // Un mapa de calor por configuración: <imagenes>/<instancia>_z<zonas>_a<alpha>.png
+    if (con_imagenes) {
+        std::filesystem::create_directories(config.imagenes);
+        for (std::size_t g = 0; g < num_grupos; ++g) {
+            if (repeticion_grupo[g] < 0) continue; // Fallaron todas las repeticiones
+            const Tarea& tarea = tareas[g * config.repeticiones];
+            const Grid<float>& terreno = *datos[tarea.instancia].front(); // Banda 0
+
+            Grid<zona_t> zonas = mejor_grupo[g].zonas_asignadas;
+            for (zona_t& zona : zonas) zona += 1; // Como en main: etiquetas desde 1
+
+            std::ostringstream nombre;
+            nombre << std::filesystem::path(nombre_instancia(config.instancias[tarea.instancia])).stem().string() << "_z"
+                   << config.zonas[tarea.zonas] << "_a" << tarea.alpha << ".png";
+            std::string ruta = (std::filesystem::path(config.imagenes) / nombre.str()).string();
+            saveHeatmap(ruta, terreno, factorHeatmap(terreno.filas(), terreno.columnas()), zonas, true);
+        }
+        std::cout << "Imagenes en: " << config.imagenes << " (" << num_grupos << ")" << std::endl;
+    }
+    if (con_estadisticas) {
+        const double memoria = memoria_pico_mb();
+        for (EstadisticasEjecucion& e : estadisticas) e.memoria_pico_mb = memoria;
+        guardar_estadisticas(opciones.archivo_estadisticas, estadisticas);
+        std::cout << "Estadisticas en: " << opciones.archivo_estadisticas << std::endl;
+    }
+    if (fallidas > 0) {
+        std::cerr << "Error: " << fallidas << " de " << tareas.size()
+                  << " ejecuciones fallaron (Arranque = error en " << ruta_ejecuciones << ")" << std::endl;
+        return 1;
+    }
+    return 0;
+}
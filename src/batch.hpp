@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include "spp.hpp"
+
+/**
+ * @brief Ejecuta una grilla de experimentos dentro del mismo proceso.
+ *
+ * Reemplaza a `batch_run.sh` + `run.sh`: lee un archivo de trabajos, carga
+ * cada instancia una sola vez y reparte todas las ejecuciones
+ * (instancia × zonas × alpha × repetición) entre `opciones.num_hilos` workers.
+ * Cada ejecución usa un solo hilo y una semilla derivada de `opciones.semilla`
+ * y de su posición en la grilla, así que el resultado es reproducible.
+ *
+ * Formato del archivo de trabajos (una clave por línea, '#' comenta):
+ *
+ *     instancias Medianas/mediana_1.spp Pequeñas/pequena_1.spp
+ *     pesos 1 0.5                                # opcional, uno por banda
+ *     zonas 4 5 6
+ *     alphas 0.2 0.3 0.4 0.5
+ *     repeticiones 10
+ *     restarts 20
+ *     salida data_csv/experimento
+ *     imagenes visual_test_results/experimento   # opcional
+ *     modo barrido                               # opcional (por defecto: grilla)
+ *     restarts_caliente 2                        # opcional, solo en barrido
+ *
+ * Una instancia `a.spp+b.spp` es multibanda (b.spp es la banda 1, como con
+ * `--banda`); `pesos` aplica a todas las instancias y por defecto vale 1.
+ * Las columnas Instancia de los CSV y los mapas de calor usan la banda 0.
+ *
+ * Escribe `<salida>_ejecuciones.csv` (una fila por ejecución) y
+ * `<salida>_resumen.csv` (mismo formato que el resumen de `graph.py`). Con
+ * `imagenes`, guarda además el mapa de calor de la mejor repetición de cada
+ * configuración como `<imagenes>/<instancia>_z<zonas>_a<alpha>.png`, sin GUI.
+ *
+ * En `modo barrido` cada (instancia, repetición) es una cadena de
+ * continuación en vez de zonas × alphas ejecuciones independientes: el
+ * primer punto (primer p, alpha más holgado) se resuelve en frío con
+ * `restarts`; los siguientes, con `restarts_caliente` restarts cuyo restart 0
+ * parte del óptimo del alpha anterior (de holgado a estricto) o, al cambiar
+ * de p, del óptimo con el alpha más holgado del p anterior tras dividir o
+ * fusionar zonas (ver barrido.hpp). Al cerrar cada p, un punto adopta la
+ * solución de un alpha más estricto si es homogénea y más barata (mismo
+ * costo con un umbral mayor). Las cadenas se reparten entre los hilos.
+ * `<salida>_ejecuciones.csv` indica además si cada punto es factible y cómo
+ * arrancó (frio, alpha, division, fusion o envolvente).
+ *
+ * @return 0 si todo salió bien; 1 si alguna ejecución falló (los CSV se
+ *         escriben igual, con esas filas marcadas como `error`).
+ */
+int ejecutar_batch(const std::string& archivo_jobs, const OpcionesBusqueda& opciones);
@@ -0,0 +1,323 @@
+/**
+ * @file bench.cpp
+ * @brief Microbenchmarks de los kernels del solver (`make bench`).
+ *
+ * Mide por separado la lectura de instancias, las varianzas y la evaluación
+ * completa (también con su implementación original de referencia), la
+ * solución inicial, los deltas de un movimiento por celda (con 1 y 4
+ * bandas), un descenso completo de Hill Climbing y una resolución
+ * multinivel (1 restart).
+ *
+ * Corre sobre una instancia real de cada tamaño y sobre grillas sintéticas
+ * de hasta 2000x2000; los descensos solo llegan a 1000x1000 (250x250 para
+ * Best Improvement). Reporta ns por operación y celdas por segundo.
+ *
+ * Uso:
+ *     ./spp_bench [--max-lado N] [--min-tiempo SEG] [--guardar-base base.txt]
+ *                 [--base base.txt] [--tolerancia 0.15]
+ *
+ * Con `--base` compara contra un archivo guardado antes con `--guardar-base`
+ * y termina con código 1 si algún kernel es más lento que la base por más de
+ * la tolerancia (regresión).
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "spp.hpp"
+#include "busqueda_lote.hpp"
+#include "evaluacion_incremental.hpp"
+#include "inicializacion.hpp"
+#include "varianza.hpp"
+
+namespace {
+
+constexpr double ALPHA_BENCH = 0.5;
+constexpr int ZONAS_BENCH = 6;
+constexpr std::uint64_t SEMILLA_BENCH = 12345;
+
+struct Medicion {
+    std::string caso;
+    std::string kernel;
+    double ns_por_op;
+    double celdas_por_seg;
+    long long repeticiones;
+};
+
+// Evita que el compilador descarte resultados que no se usan
+volatile double sumidero = 0.0;
+
+/**
+ * @brief Repite `f` hasta acumular `min_tiempo` segundos (al menos una vez,
+ * tras un calentamiento) y devuelve los ns promedio por llamada.
+ */
+double medir(const std::function<void()>& f, double min_tiempo, long long& repeticiones) {
+    using reloj = std::chrono::steady_clock;
+    f(); // Calentamiento (caché, páginas, asignaciones)
+
+    repeticiones = 0;
+    double total = 0.0;
+    long long lote = 1;
+    while (total < min_tiempo) {
+        auto inicio = reloj::now();
+        for (long long k = 0; k < lote; ++k) f();
+        total += std::chrono::duration<double>(reloj::now() - inicio).count();
+        repeticiones += lote;
+        if (total < min_tiempo / 10) lote *= 2;
+    }
+    return total * 1e9 / repeticiones;
+}
+
+/**
+ * @brief Terreno sintético suave (suma de senos) con ruido, reproducible.
+ */
+Grid<float> terreno_sintetico(int lado, std::uint64_t semilla) {
+    std::mt19937 gen = generador_para(semilla, static_cast<std::uint64_t>(lado));
+    std::normal_distribution<float> ruido(0.0f, 2.0f);
+
+    Grid<float> datos(lado, lado);
+    for (int i = 0; i < lado; ++i) {
+        for (int j = 0; j < lado; ++j) {
+            double x = static_cast<double>(i) / lado;
+            double y = static_cast<double>(j) / lado;
+            double base = 50.0 + 15.0 * std::sin(6.0 * x) * std::cos(4.0 * y) + 10.0 * std::sin(11.0 * (x + y));
+            datos(i, j) = static_cast<float>(base) + ruido(gen);
+        }
+    }
+    return datos;
+}
+
+/**
+ * @brief Corre todos los kernels sobre la instancia en `ruta_spp`.
+ */
+void medir_caso(const std::string& caso, const std::string& ruta_spp, double min_tiempo,
+                std::vector<Medicion>& mediciones) {
+
+    // La caché de prueba va al directorio temporal: junto a la instancia
+    // pisaría (y después borraría) la .sppb que el usuario ya tuviera
+    std::string ruta_sppb =
+        (std::filesystem::temp_directory_path() / ("spp_bench_" + caso + ".sppb")).string();
+    escribir_sppb(ruta_sppb, leer_datos(ruta_spp, false));
+
+    Instancia instancia(leer_datos(ruta_spp, false), ZONAS_BENCH);
+    const double celdas = static_cast<double>(instancia.N_filas) * instancia.M_columnas;
+    const double umbral = ALPHA_BENCH * calcular_varianza_total(instancia);
+
+    std::vector<float> valores(instancia.datos_terreno.begin(), instancia.datos_terreno.end());
+    std::mt19937 gen_fijo = generador_para(SEMILLA_BENCH, 0);
+    Solucion sol_inicial = generar_solucion_inicial_aleatoria(instancia, gen_fijo);
+
+    // Un descenso completo en instancias enormes tarda demasiado para repetirlo
+    // (Best Improvement hace muchas más rondas: en 1000x1000 pasa del minuto)
+    bool medir_first = celdas <= 1000.0 * 1000.0;
+    bool medir_best = celdas <= 250.0 * 250.0;
+
+    // Los lectores se miden hasta tocar todos los valores: la vista .sppb
+    // no lee nada del disco hasta que se usa
+    auto sumar = [](const Grid<float>& g) {
+        double total = 0.0;
+        for (float x : g) total += x;
+        return total;
+    };
+
+    auto agregar = [&](const std::string& kernel, const std::function<void()>& f) {
+        long long repeticiones = 0;
+        double ns = medir(f, min_tiempo, repeticiones);
+        mediciones.push_back({caso, kernel, ns, celdas / (ns * 1e-9), repeticiones});
+
+        const Medicion& m = mediciones.back();
+        std::cout << std::left << std::setw(18) << m.caso << std::setw(26) << m.kernel << std::right
+                  << std::setw(16) << std::fixed << std::setprecision(0) << m.ns_por_op
+                  << std::setw(14) << std::setprecision(2) << m.celdas_por_seg / 1e6
+                  << std::setw(10) << m.repeticiones << std::endl;
+    };
+
+    agregar("leer_datos(.spp)", [&] { sumidero = sumidero + sumar(leer_datos(ruta_spp, false)); });
+    agregar("leer_datos(.sppb)", [&] { sumidero = sumidero + sumar(leer_datos(ruta_sppb)); });
+    agregar("leer_spp_ifstream", [&] { sumidero = sumidero + sumar(leer_spp_ifstream(ruta_spp)); });
+    agregar("calcular_varianza", [&] { sumidero = sumidero + calcular_varianza(valores); });
+    agregar("calcular_varianza_total", [&] { sumidero = sumidero + calcular_varianza_total(instancia); });
+    agregar("varianza_total_ref", [&] { sumidero = sumidero + calcular_varianza_total_referencia(instancia); });
+    agregar("evaluar_solucion", [&] { sumidero = sumidero + evaluar_solucion(instancia, sol_inicial, umbral); });
+    agregar("evaluar_solucion_ref", [&] {
+        sumidero = sumidero + evaluar_solucion_referencia(instancia, sol_inicial, umbral);
+    });
+    agregar("solucion_inicial", [&] {
+        std::mt19937 gen = generador_para(SEMILLA_BENCH, 0);
+        sumidero = sumidero + generar_solucion_inicial_aleatoria(instancia, gen).zonas_asignadas[0];
+    });
+    agregar("solucion_inicial_voronoi", [&] {
+        std::mt19937 gen = generador_para(SEMILLA_BENCH, 0);
+        sumidero = sumidero + generar_solucion_inicial_voronoi(instancia, gen).zonas_asignadas[0];
+    });
+    agregar("solucion_inicial_crecim", [&] {
+        std::mt19937 gen = generador_para(SEMILLA_BENCH, 0);
+        sumidero = sumidero + generar_solucion_inicial_crecimiento(instancia, gen).zonas_asignadas[0];
+    });
+
+    // Un delta por celda (cada una hacia la zona siguiente), con 1 y con 4 bandas:
+    // las bandas extra son la misma grilla invertida, escalada y desplazada
+    auto medir_deltas = [&](const std::string& kernel, const Instancia& inst) {
+        Solucion sol = sol_inicial;
+        EstadoEvaluacion estado(inst, sol, umbral);
+        agregar(kernel, [&] {
+            double total = 0.0;
+            for (int i = 0; i < inst.N_filas; ++i) {
+                for (int j = 0; j < inst.M_columnas; ++j) {
+                    total += estado.delta_movimiento(i, j, (sol.zonas_asignadas(i, j) + 1) % ZONAS_BENCH);
+                }
+            }
+            sumidero = sumidero + total;
+        });
+    };
+    std::vector<Grid<float>> bandas(4, instancia.datos_terreno);
+    std::reverse(bandas[1].begin(), bandas[1].end());
+    for (float& x : bandas[2]) x = 3.0f * x + 10.0f;
+    for (float& x : bandas[3]) x = 100.0f - x;
+    Instancia instancia_bandas(std::move(bandas), {1.0, 0.5, 0.25, 2.0}, ZONAS_BENCH);
+    medir_deltas("delta_movimiento", instancia);
+    medir_deltas("delta_movimiento_4_bandas", instancia_bandas);
+
+    if (medir_first) {
+        agregar("hc_first_improvement", [&] {
+            sumidero = sumidero + hill_climbing_first_improvement(instancia, sol_inicial, umbral).costo;
+        });
+    }
+    if (medir_best) {
+        agregar("hc_best_improvement", [&] {
+            sumidero = sumidero + hill_climbing_best_improvement(instancia, sol_inicial, umbral, 1).costo;
+        });
+    }
+
+    // Multinivel: restarts en el nivel grueso + refinamiento, en todos los tamaños
+    OpcionesBusqueda multinivel;
+    multinivel.num_restarts = 1;
+    multinivel.semilla = SEMILLA_BENCH;
+    multinivel.reportar_mejoras = false;
+    multinivel.multinivel = true;
+    agregar("resolver_multinivel", [&] {
+        sumidero = sumidero + resolver_con_restart(instancia, umbral, multinivel).costo;
+    });
+
+    std::remove(ruta_sppb.c_str());
+}
+
+std::map<std::string, double> leer_base(const std::string& ruta) {
+    std::ifstream in(ruta);
+    if (!in.is_open()) {
+        throw std::runtime_error("No se pudo abrir el archivo: " + ruta);
+    }
+    std::map<std::string, double> base;
+    std::string caso, kernel;
+    double ns;
+    while (in >> caso >> kernel >> ns) base[caso + " " + kernel] = ns;
+    return base;
+}
+
+void guardar_base(const std::string& ruta, const std::vector<Medicion>& mediciones) {
+    std::ofstream out(ruta);
+    if (!out.is_open()) {
+        throw std::runtime_error("No se pudo escribir el archivo: " + ruta);
+    }
+    out << std::setprecision(10);
+    for (const Medicion& m : mediciones) out << m.caso << " " << m.kernel << " " << m.ns_por_op << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int max_lado = 2000;
+    double min_tiempo = 0.2;
+    double tolerancia = 0.15;
+    std::string archivo_base, archivo_guardar;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hay_valor = (i + 1 < argc);
+        if (arg == "--max-lado" && hay_valor) {
+            max_lado = std::stoi(argv[++i]);
+        } else if (arg == "--min-tiempo" && hay_valor) {
+            min_tiempo = std::stod(argv[++i]);
+        } else if (arg == "--tolerancia" && hay_valor) {
+            tolerancia = std::stod(argv[++i]);
+        } else if (arg == "--base" && hay_valor) {
+            archivo_base = argv[++i];
+        } else if (arg == "--guardar-base" && hay_valor) {
+            archivo_guardar = argv[++i];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--max-lado N] [--min-tiempo SEG] [--guardar-base base.txt]"
+                      << " [--base base.txt] [--tolerancia 0.15]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Medicion> mediciones;
+    try {
+        std::cout << std::left << std::setw(18) << "Caso" << std::setw(26) << "Kernel" << std::right
+                  << std::setw(16) << "ns/op" << std::setw(14) << "Mceldas/s" << std::setw(10) << "reps" << std::endl;
+
+        // Una instancia real de cada tamaño
+        const std::vector<std::pair<std::string, std::string>> reales = {
+            {"pequena_1", "instances/Pequeñas/pequena_1.spp"},
+            {"mediana_1", "instances/Medianas/mediana_1.spp"},
+            {"grande_1", "instances/Grandes/grande_1.spp"},
+        };
+        for (const auto& [caso, ruta] : reales) {
+            if (!std::filesystem::exists(ruta)) {
+                std::cerr << "Aviso: no existe " << ruta << " (ejecutar desde la raíz del repositorio)" << std::endl;
+                continue;
+            }
+            medir_caso(caso, ruta, min_tiempo, mediciones);
+        }
+
+        // Grillas sintéticas, escritas como .spp temporales
+        std::filesystem::path temporal = std::filesystem::temp_directory_path();
+        for (int lado : {250, 500, 1000, 2000}) {
+            if (lado > max_lado) break;
+            std::string caso = "sintetica_" + std::to_string(lado);
+            std::string ruta = (temporal / ("spp_bench_" + std::to_string(lado) + ".spp")).string();
+            escribir_spp(ruta, terreno_sintetico(lado, SEMILLA_BENCH));
+            medir_caso(caso, ruta, min_tiempo, mediciones);
+            std::remove(ruta.c_str());
+        }
+
+        if (!archivo_guardar.empty()) {
+            guardar_base(archivo_guardar, mediciones);
+            std::cout << "Base guardada en: " << archivo_guardar << std::endl;
+        }
+
+        if (!archivo_base.empty()) {
+            std::map<std::string, double> base = leer_base(archivo_base);
+            int regresiones = 0;
+            std::cout << "\nComparación con " << archivo_base << " (tolerancia " << tolerancia * 100 << "%)" << std::endl;
+            for (const Medicion& m : mediciones) {
+                auto it = base.find(m.caso + " " + m.kernel);
+                if (it == base.end()) continue;
+                double razon = m.ns_por_op / it->second;
+                bool regresion = razon > 1.0 + tolerancia;
+                regresiones += regresion;
+                std::cout << std::left << std::setw(18) << m.caso << std::setw(26) << m.kernel << std::right
+                          << std::setw(10) << std::setprecision(2) << razon << "x"
+                          << (regresion ? "  REGRESION" : "") << std::endl;
+            }
+            if (regresiones > 0) {
+                std::cout << regresiones << " kernel(s) más lentos que la base" << std::endl;
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
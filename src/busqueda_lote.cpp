@@ -0,0 +1,383 @@
+#include "busqueda_lote.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "evaluacion_incremental.hpp"
+#include "frontera.hpp"
+#include "presupuesto.hpp"
+#include "conectividad.hpp"
+
+void LoteMovimientos::clear() {
+    celda.clear();
+    valor.clear();
+    origen.clear();
+    destino.clear();
+    delta_islas.clear();
+    delta.clear();
+}
+
+void LoteMovimientos::agregar(int indice, float x, zona_t zona_origen, zona_t zona_destino, int islas) {
+    celda.push_back(indice);
+    valor.push_back(x);
+    origen.push_back(zona_origen);
+    destino.push_back(zona_destino);
+    delta_islas.push_back(islas);
+}
+
+namespace {
+
+/**
+ * @brief Varianza + penalización de homogeneidad de una zona, sin ramas.
+ */
+inline double costo_zona_sin_ramas(double n, double s, double q, double umbral_varianza) {
+    double inv = 1.0 / std::max(n, 1.0);
+    double media = s * inv;
+    double varianza = std::max(q * inv - media * media, 0.0);
+    varianza = (n > 1.0) ? varianza : 0.0; // Varianza de 0 o 1 elemento es 0.
+    return varianza + std::max(varianza - umbral_varianza, 0.0) * PENALIZACION_HOMOGENEIDAD;
+}
+
+/**
+ * @brief Barrera reutilizable para un número fijo de hilos (std::barrier es de C++20).
+ */
+class Barrera {
+public:
+    explicit Barrera(int participantes) : participantes(participantes) {}
+
+    void esperar() {
+        std::unique_lock<std::mutex> lock(cerrojo);
+        const unsigned long generacion_actual = generacion;
+        if (++llegados == participantes) {
+            llegados = 0;
+            ++generacion;
+            cv.notify_all();
+            return;
+        }
+        cv.wait(lock, [&] { return generacion != generacion_actual; });
+    }
+
+private:
+    std::mutex cerrojo;
+    std::condition_variable cv;
+    int participantes;
+    int llegados = 0;
+    unsigned long generacion = 0;
+};
+
+/**
+ * @brief Hilos persistentes de los barridos: se crean una vez por descenso y
+ * cada barrido cuesta dos barreras (arranque y fin) en vez de crear y unir
+ * `num_hilos` hilos. El hilo que llama a `ejecutar` hace la parte 0.
+ *
+ * Una excepción de `tarea` no sale del hilo (terminaría el proceso): se
+ * guarda y `ejecutar` la relanza tras la barrera de fin.
+ */
+class EquipoBarrido {
+public:
+    EquipoBarrido(int num_hilos, std::function<void(int)> tarea)
+        : tarea(std::move(tarea)), inicio(num_hilos), fin(num_hilos), errores(num_hilos) {
+        for (int t = 1; t < num_hilos; ++t) {
+            hilos.emplace_back([this, t]() {
+                while (true) {
+                    inicio.esperar();
+                    if (terminar) return;
+                    correr(t);
+                    fin.esperar();
+                }
+            });
+        }
+    }
+
+    ~EquipoBarrido() {
+        terminar = true;
+        if (!hilos.empty()) inicio.esperar();
+        for (auto& h : hilos) h.join();
+    }
+
+    EquipoBarrido(const EquipoBarrido&) = delete;
+    EquipoBarrido& operator=(const EquipoBarrido&) = delete;
+
+    void ejecutar() {
+        inicio.esperar();
+        correr(0);
+        fin.esperar();
+        for (std::exception_ptr& error : errores) {
+            if (error) std::rethrow_exception(std::exchange(error, nullptr));
+        }
+    }
+
+private:
+    std::function<void(int)> tarea;
+    Barrera inicio, fin;
+    std::vector<std::exception_ptr> errores;
+    std::vector<std::thread> hilos;
+    bool terminar = false; // Se lee tras la barrera de inicio, que sincroniza
+
+    void correr(int t) {
+        try {
+            tarea(t);
+        } catch (...) {
+            errores[t] = std::current_exception();
+        }
+    }
+};
+
+// Con menos celdas por hilo en la lista de trabajo, el barrido va en un solo hilo
+constexpr std::size_t MIN_CELDAS_POR_HILO = 256;
+
+} // namespace
+
+void delta_varianza_lote(const float* __restrict valor, const zona_t* __restrict origen,
+                         const zona_t* __restrict destino, std::size_t n,
+                         const double* __restrict conteo, const double* __restrict suma,
+                         const double* __restrict suma_cuadrados, const double* __restrict costo_zona,
+                         double umbral_varianza, double* __restrict delta) {
+#pragma GCC ivdep
+    for (std::size_t k = 0; k < n; ++k) {
+        double x = valor[k];
+        double x2 = x * x;
+        int a = origen[k];
+        int b = destino[k];
+
+        double nuevo_a = costo_zona_sin_ramas(conteo[a] - 1.0, suma[a] - x, suma_cuadrados[a] - x2, umbral_varianza);
+        double nuevo_b = costo_zona_sin_ramas(conteo[b] + 1.0, suma[b] + x, suma_cuadrados[b] + x2, umbral_varianza);
+        delta[k] = (nuevo_a - costo_zona[a]) + (nuevo_b - costo_zona[b]);
+    }
+}
+
+Solucion hill_climbing_best_improvement(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                                        int num_hilos, bool verificar_delta, Presupuesto* presupuesto,
+                                        bool conexo) {
+
+    // delta_varianza_lote lee una suma por zona: con varias bandas daría deltas de la banda 0
+    if (instancia.num_bandas() != 1) {
+        throw std::runtime_error("Best Improvement por lotes solo admite instancias de una banda");
+    }
+
+    EstadoEvaluacion estado(instancia, sol_actual, umbral_varianza, verificar_delta);
+    FronteraZonas frontera(sol_actual.zonas_asignadas);
+
+    const int N = instancia.N_filas;
+    const int M = instancia.M_columnas;
+    const int p = instancia.num_zonas;
+
+    // Menos de ~16 filas por hilo no compensa repartir el barrido
+    num_hilos = std::max(1, std::min(num_hilos, N / 16));
+
+    std::vector<LoteMovimientos> lotes(num_hilos);
+    std::vector<double> conteo(p);
+    std::vector<char> movida(sol_actual.zonas_asignadas.size(), 0);
+    bool detenido = false; // Presupuesto agotado: se aplica el último barrido y se termina
+
+    // Con --conexo cada hilo necesita sus propios buffers de búsqueda
+    std::vector<ConectividadZonas> conectividad;
+    if (conexo) conectividad.assign(num_hilos, ConectividadZonas(N, M));
+    std::vector<long long> rechazos(num_hilos, 0);
+
+    // Lista de trabajo, como en First Improvement: al principio toda la
+    // frontera; después de cada barrido, las celdas movidas y sus 4-vecinas.
+    // Una lista parcial sin mejoras no es un óptimo local, así que entonces
+    // se barre la frontera entera antes de terminar
+    std::vector<int> pendientes;
+    std::vector<char> en_cola(sol_actual.zonas_asignadas.size(), 0);
+    bool frontera_entera = false;
+
+    auto encolar = [&](int indice) {
+        if (!en_cola[indice] && frontera.contiene(indice)) {
+            en_cola[indice] = 1;
+            pendientes.push_back(indice);
+        }
+    };
+    auto encolar_frontera = [&]() {
+        for (int indice : frontera.celdas()) encolar(indice);
+        frontera_entera = true;
+    };
+
+    // Parámetros del barrido en curso, fijados antes de soltar a los hilos
+    bool completo = false;
+    int partes = 1;
+
+    // Genera y puntúa los candidatos de la parte t en `lotes[t]`: un tramo de
+    // `pendientes` o, en modo completo, un bloque de filas donde se prueba
+    // cualquier celda hacia cualquier otra zona
+    auto barrer = [&](int t) {
+        LoteMovimientos& lote = lotes[t];
+        lote.clear();
+        if (t >= partes) return;
+        const Grid<zona_t>& zonas = sol_actual.zonas_asignadas;
+
+        if (completo) {
+            int fila_ini = static_cast<int>(static_cast<long long>(N) * t / partes);
+            int fila_fin = static_cast<int>(static_cast<long long>(N) * (t + 1) / partes);
+            for (int i = fila_ini; i < fila_fin; ++i) {
+                for (int j = 0; j < M; ++j) {
+                    zona_t zona_original = zonas(i, j);
+                    for (int z = 0; z < p; ++z) {
+                        if (z == zona_original) continue;
+                        lote.agregar(i * M + j, instancia.datos_terreno(i, j), zona_original, z,
+                                     estado.delta_islas(i, j, z));
+                    }
+                }
+            }
+        } else {
+            std::size_t ini = pendientes.size() * t / partes;
+            std::size_t fin = pendientes.size() * (t + 1) / partes;
+            for (std::size_t k = ini; k < fin; ++k) {
+                int indice = pendientes[k];
+                // Un movimiento del lote anterior pudo sacarla de la frontera
+                if (!frontera.contiene(indice)) continue;
+                int i = indice / M;
+                int j = indice % M;
+                if (conexo && !conectividad[t].puede_salir(zonas, i, j)) {
+                    ++rechazos[t];
+                    continue;
+                }
+                zona_t candidatas[4];
+                int num_candidatas = FronteraZonas::zonas_vecinas(zonas, i, j, candidatas);
+                for (int c = 0; c < num_candidatas; ++c) {
+                    lote.agregar(indice, instancia.datos_terreno(i, j), zonas(i, j), candidatas[c],
+                                 estado.delta_islas(i, j, candidatas[c]));
+                }
+            }
+        }
+
+        lote.delta.resize(lote.size());
+        delta_varianza_lote(lote.valor.data(), lote.origen.data(), lote.destino.data(), lote.size(),
+                            conteo.data(), estado.sumas().data(), estado.sumas_cuadrados().data(),
+                            estado.costos_zona().data(), umbral_varianza, lote.delta.data());
+        for (std::size_t k = 0; k < lote.size(); ++k) {
+            lote.delta[k] += lote.delta_islas[k] * M_ISLA;
+        }
+    };
+
+    EquipoBarrido equipo(num_hilos, barrer);
+
+    // Un barrido (de la lista de trabajo, o completo); devuelve los candidatos
+    // que mejoran como pares (lote, posición), en orden de celda
+    auto barrido_paralelo = [&](bool modo_completo) {
+        for (int k = 0; k < p; ++k) conteo[k] = static_cast<double>(estado.conteos()[k]);
+
+        completo = modo_completo;
+        if (completo) {
+            partes = num_hilos;
+        } else {
+            // Ordenada, la lista se reparte igual con cualquier número de
+            // hilos y cada hilo recorre memoria cercana
+            std::sort(pendientes.begin(), pendientes.end());
+            partes = static_cast<int>(std::min<std::size_t>(num_hilos,
+                                                            std::max<std::size_t>(1, pendientes.size() / MIN_CELDAS_POR_HILO)));
+        }
+        if (partes == 1) {
+            for (int t = 1; t < num_hilos; ++t) lotes[t].clear();
+            barrer(0);
+        } else {
+            equipo.ejecutar();
+        }
+        if (!completo) {
+            for (int indice : pendientes) en_cola[indice] = 0;
+            pendientes.clear();
+        }
+
+        std::vector<std::pair<int, int>> mejoras;
+        long long evaluados = 0;
+        for (int t = 0; t < num_hilos; ++t) {
+            evaluados += static_cast<long long>(lotes[t].size());
+            for (std::size_t k = 0; k < lotes[t].size(); ++k) {
+                if (lotes[t].delta[k] < -EPSILON_MEJORA) mejoras.emplace_back(t, static_cast<int>(k));
+            }
+        }
+        estado.contadores().movimientos_probados += evaluados;
+        ++estado.contadores().pasadas;
+        if (presupuesto && presupuesto->consumir(evaluados)) detenido = true;
+        return mejoras;
+    };
+
+    encolar_frontera();
+    while (!detenido) {
+        bool barrio_frontera = frontera_entera;
+        auto mejoras = barrido_paralelo(false);
+        if (mejoras.empty() && !barrio_frontera) {
+            encolar_frontera();
+            continue;
+        }
+        if (mejoras.empty() && estado.penalizada() && !detenido && !conexo) {
+            // Con penalizaciones activas también vale mover celdas interiores
+            mejoras = barrido_paralelo(true);
+        }
+        if (mejoras.empty()) break; // Ningún vecino mejora -> óptimo local
+
+        // Mejores primero; el orden estable (por celda) hace el resultado determinista
+        std::stable_sort(mejoras.begin(), mejoras.end(), [&](const auto& a, const auto& b) {
+            return lotes[a.first].delta[a.second] < lotes[b.first].delta[b.second];
+        });
+
+        // Aplicamos en lote: cada candidato se revalida contra el estado ya
+        // modificado por los anteriores, así nunca empeora el costo
+        std::vector<int> movidas;
+        for (const auto& m : mejoras) {
+            const LoteMovimientos& lote = lotes[m.first];
+            int indice = lote.celda[m.second];
+            if (movida[indice]) continue;
+
+            int i = indice / M;
+            int j = indice % M;
+            if (sol_actual.zonas_asignadas(i, j) != lote.origen[m.second]) continue;
+
+            int destino = lote.destino[m.second];
+            if (conexo) {
+                // Los movimientos ya aplicados en esta ronda pueden haber cambiado
+                // la vecindad: la celda debe seguir tocando el destino y poder salir
+                zona_t vecinas[4];
+                int num_vecinas = FronteraZonas::zonas_vecinas(sol_actual.zonas_asignadas, i, j, vecinas);
+                if (std::find(vecinas, vecinas + num_vecinas, destino) == vecinas + num_vecinas) continue;
+                if (!conectividad[0].puede_salir(sol_actual.zonas_asignadas, i, j)) {
+                    ++rechazos[0];
+                    continue;
+                }
+            }
+            if (estado.delta_movimiento(i, j, destino) < -EPSILON_MEJORA) {
+                estado.aplicar_movimiento(i, j, destino);
+                frontera.actualizar_alrededor(i, j);
+                movida[indice] = 1;
+                movidas.push_back(indice);
+            }
+        }
+
+        // Solo mejoraban por redondeo del kernel: si no era la frontera entera, se prueba con ella
+        if (movidas.empty()) {
+            if (barrio_frontera) break;
+            encolar_frontera();
+            continue;
+        }
+
+        // Próxima lista: las celdas movidas y sus vecinas, más las que
+        // mejoraban pero no pasaron la revalidación
+        frontera_entera = false;
+        for (int indice : movidas) {
+            movida[indice] = 0;
+            int i = indice / M;
+            int j = indice % M;
+            encolar(indice);
+            if (i > 0) encolar(indice - M);
+            if (i + 1 < N) encolar(indice + M);
+            if (j > 0) encolar(indice - 1);
+            if (j + 1 < M) encolar(indice + 1);
+        }
+        for (const auto& m : mejoras) encolar(lotes[m.first].celda[m.second]);
+        if (presupuesto) presupuesto->reportar_costo(estado.costo());
+    }
+
+    for (long long r : rechazos) estado.contadores().rechazos_conectividad += r;
+    contadores_hilo().sumar(estado.contadores());
+
+    // Costo final exacto, con la misma función que reportamos al usuario
+    sol_actual.costo = evaluar_solucion(instancia, sol_actual, umbral_varianza);
+    return sol_actual;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "spp.hpp"
+
+/**
+ * @struct LoteMovimientos
+ * @brief Movimientos candidatos en formato SoA (un arreglo por campo), para
+ * que el kernel de puntuación recorra memoria contigua y se pueda vectorizar.
+ */
+struct LoteMovimientos {
+    std::vector<int> celda;          // Índice lineal i * M + j
+    std::vector<float> valor;        // Valor del terreno en la celda
+    std::vector<zona_t> origen;
+    std::vector<zona_t> destino;
+    std::vector<int> delta_islas;
+    std::vector<double> delta;       // Salida del kernel
+
+    void clear();
+    void agregar(int indice, float x, zona_t zona_origen, zona_t zona_destino, int islas);
+    std::size_t size() const { return celda.size(); }
+};
+
+/**
+ * @brief Kernel vectorizable: delta de la parte de varianzas (y penalización
+ * de homogeneidad) de `n` movimientos a la vez, a partir de las estadísticas
+ * por zona (conteo, suma, suma de cuadrados y costo actual de cada zona).
+ *
+ * Sin ramas ni dependencias entre iteraciones: el compilador lo traduce a
+ * instrucciones SIMD con -O2/-O3. Solo con una banda (una entrada por zona).
+ */
+void delta_varianza_lote(const float* valor, const zona_t* origen, const zona_t* destino, std::size_t n,
+                         const double* conteo, const double* suma, const double* suma_cuadrados,
+                         const double* costo_zona, double umbral_varianza, double* delta);
+
+/**
+ * @brief Hill Climbing "Best Improvement" por lotes, en paralelo.
+ *
+ * En cada iteración puntúa los movimientos de una lista de trabajo de celdas
+ * de frontera, repartida entre `num_hilos` hilos persistentes (creados una
+ * vez por descenso y sincronizados con barreras), ordena los que mejoran y
+ * aplica en lote los que siguen mejorando al revalidarlos contra el estado
+ * ya modificado (así los movimientos que chocan entre sí, por compartir zona
+ * o vecindad, nunca empeoran el costo). La lista empieza con toda la
+ * frontera y después tiene las celdas movidas y sus 4-vecinas; cuando no
+ * da mejoras se barre la frontera entera antes de declarar un óptimo local.
+ * El resultado no depende del número de hilos.
+ *
+ * Con `presupuesto`, cada barrido cuenta sus candidatos como evaluaciones y
+ * la búsqueda se detiene (devolviendo la solución actual) al agotarse.
+ * Con `conexo`, igual que en First Improvement: solo movimientos que dejan
+ * todas las zonas 4-conexas (revalidados también al aplicar el lote).
+ * Lanza std::runtime_error con una instancia multibanda.
+ */
+Solucion hill_climbing_best_improvement(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                                        int num_hilos, bool verificar_delta = false,
+                                        Presupuesto* presupuesto = nullptr, bool conexo = false);
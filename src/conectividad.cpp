@@ -0,0 +1,244 @@
+#include "conectividad.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// Anillo de 8 vecinos en orden circular: N, NE, E, SE, S, SO, O, NO.
+// Las posiciones pares son los 4-vecinos; dos posiciones consecutivas son
+// 4-adyacentes entre sí, así que una racha de celdas de la zona en el anillo
+// es un camino que rodea a la celda central.
+constexpr int ANILLO_DR[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+constexpr int ANILLO_DC[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+constexpr std::uint8_t BLOQUEADA = 255;
+
+/**
+ * @brief Etiqueta las componentes 4-conexas de cada zona. Devuelve el
+ * número de componentes y llena `componente` (por celda) y `tamano`.
+ */
+int etiquetar_componentes(const Grid<zona_t>& zonas, std::vector<int>& componente, std::vector<int>& tamano) {
+    const int N = zonas.filas();
+    const int M = zonas.columnas();
+    componente.assign(zonas.size(), -1);
+    tamano.clear();
+
+    std::vector<int> cola;
+    for (int inicio = 0; inicio < static_cast<int>(zonas.size()); ++inicio) {
+        if (componente[inicio] >= 0) continue;
+        int id = static_cast<int>(tamano.size());
+        zona_t z = zonas[inicio];
+
+        cola.clear();
+        cola.push_back(inicio);
+        componente[inicio] = id;
+        for (std::size_t frente = 0; frente < cola.size(); ++frente) {
+            int indice = cola[frente];
+            int i = indice / M;
+            int j = indice % M;
+            auto visitar = [&](int vecino) {
+                if (componente[vecino] < 0 && zonas[vecino] == z) {
+                    componente[vecino] = id;
+                    cola.push_back(vecino);
+                }
+            };
+            if (i > 0) visitar(indice - M);
+            if (i + 1 < N) visitar(indice + M);
+            if (j > 0) visitar(indice - 1);
+            if (j + 1 < M) visitar(indice + 1);
+        }
+        tamano.push_back(static_cast<int>(cola.size()));
+    }
+    return static_cast<int>(tamano.size());
+}
+
+} // namespace
+
+ConectividadZonas::ConectividadZonas(int filas, int columnas, int limite_visitas)
+    : N(filas), M(columnas), limite_visitas(limite_visitas),
+      marca(static_cast<std::size_t>(filas) * columnas, 0), grupo(static_cast<std::size_t>(filas) * columnas, 0),
+      sello(0) {}
+
+int ConectividadZonas::grupos_anillo(const Grid<zona_t>& zonas, int i, int j, int representantes[4]) {
+    const int N = zonas.filas();
+    const int M = zonas.columnas();
+    zona_t z = zonas(i, j);
+
+    bool en_zona[8];
+    int primera_fuera = -1;
+    for (int k = 0; k < 8; ++k) {
+        int ni = i + ANILLO_DR[k];
+        int nj = j + ANILLO_DC[k];
+        en_zona[k] = (ni >= 0 && ni < N && nj >= 0 && nj < M && zonas(ni, nj) == z);
+        if (!en_zona[k] && primera_fuera < 0) primera_fuera = k;
+    }
+    if (primera_fuera < 0) return -1; // Celda interior: el anillo completo la rodea
+
+    // Rachas del anillo que contienen algún 4-vecino = grupos locales
+    int num_grupos = 0;
+    int representante_actual = -1;
+    for (int paso = 1; paso <= 8; ++paso) {
+        int k = (primera_fuera + paso) % 8;
+        if (en_zona[k]) {
+            if (k % 2 == 0 && representante_actual < 0) {
+                representante_actual = (i + ANILLO_DR[k]) * M + (j + ANILLO_DC[k]);
+            }
+        } else if (representante_actual >= 0) {
+            representantes[num_grupos++] = representante_actual;
+            representante_actual = -1;
+        }
+    }
+    return num_grupos;
+}
+
+bool ConectividadZonas::puede_salir(const Grid<zona_t>& zonas, int i, int j) {
+    int representantes[4];
+    int num_grupos = grupos_anillo(zonas, i, j, representantes);
+
+    if (num_grupos < 0) return true;   // Celda interior
+    if (num_grupos == 0) return false; // Zona de una sola celda: quedaría vacía
+    if (num_grupos == 1) return true;  // Desvío local por el anillo
+    return busqueda_acotada(zonas, i, j, representantes, num_grupos);
+}
+
+bool ConectividadZonas::puede_salir_local(const Grid<zona_t>& zonas, int i, int j) {
+    int representantes[4];
+    int num_grupos = grupos_anillo(zonas, i, j, representantes);
+    return num_grupos < 0 || num_grupos == 1;
+}
+
+bool ConectividadZonas::busqueda_acotada(const Grid<zona_t>& zonas, int i, int j, const int* representantes,
+                                         int num_grupos) {
+    if (++sello == 0) {
+        std::fill(marca.begin(), marca.end(), 0);
+        sello = 1;
+    }
+
+    zona_t z = zonas(i, j);
+    int centro = i * M + j;
+    marca[centro] = sello;
+    grupo[centro] = BLOQUEADA;
+
+    int padre[4];
+    std::size_t cabeza[4];
+    for (int g = 0; g < num_grupos; ++g) {
+        padre[g] = g;
+        cabeza[g] = 0;
+        colas[g].clear();
+        colas[g].push_back(representantes[g]);
+        marca[representantes[g]] = sello;
+        grupo[representantes[g]] = static_cast<std::uint8_t>(g);
+    }
+    auto raiz = [&](int g) {
+        while (padre[g] != g) g = padre[g];
+        return g;
+    };
+
+    int grupos_separados = num_grupos;
+    int visitas = 0;
+    while (visitas < limite_visitas) {
+        // Un paso de cada frente, por turnos: el pedazo más chico se agota primero
+        for (int g = 0; g < num_grupos; ++g) {
+            if (cabeza[g] == colas[g].size()) continue;
+            int indice = colas[g][cabeza[g]++];
+            ++visitas;
+
+            int ci = indice / M;
+            int cj = indice % M;
+            int vecinos[4];
+            int num_vecinos = 0;
+            if (ci > 0) vecinos[num_vecinos++] = indice - M;
+            if (ci + 1 < N) vecinos[num_vecinos++] = indice + M;
+            if (cj > 0) vecinos[num_vecinos++] = indice - 1;
+            if (cj + 1 < M) vecinos[num_vecinos++] = indice + 1;
+
+            for (int v = 0; v < num_vecinos; ++v) {
+                int vecino = vecinos[v];
+                if (zonas[vecino] != z) continue;
+                if (marca[vecino] != sello) {
+                    marca[vecino] = sello;
+                    grupo[vecino] = static_cast<std::uint8_t>(g);
+                    colas[g].push_back(vecino);
+                } else if (grupo[vecino] != BLOQUEADA) {
+                    int a = raiz(g);
+                    int b = raiz(grupo[vecino]);
+                    if (a != b) {
+                        padre[a] = b;
+                        if (--grupos_separados == 1) return true; // Todos los frentes se juntaron
+                    }
+                }
+            }
+        }
+
+        // Un conjunto de frentes ya unidos que no puede crecer quedó encerrado
+        for (int g = 0; g < num_grupos; ++g) {
+            if (raiz(g) != g) continue;
+            bool activo = false;
+            for (int h = 0; h < num_grupos && !activo; ++h) {
+                activo = (raiz(h) == g && cabeza[h] < colas[h].size());
+            }
+            if (!activo) return false;
+        }
+    }
+    return false; // Sin respuesta dentro del límite: se rechaza por las dudas
+}
+
+bool zonas_conexas(const Grid<zona_t>& zonas, int num_zonas) {
+    std::vector<int> componente, tamano;
+    etiquetar_componentes(zonas, componente, tamano);
+
+    std::vector<int> componentes_por_zona(num_zonas, 0);
+    std::vector<char> contada(tamano.size(), 0);
+    for (std::size_t indice = 0; indice < zonas.size(); ++indice) {
+        int c = componente[indice];
+        if (contada[c]) continue;
+        contada[c] = 1;
+        if (++componentes_por_zona[zonas[indice]] > 1) return false;
+    }
+    return true;
+}
+
+void reparar_conectividad(Solucion& sol, int num_zonas) {
+    Grid<zona_t>& zonas = sol.zonas_asignadas;
+    const int N = zonas.filas();
+    const int M = zonas.columnas();
+
+    std::vector<int> componente, tamano;
+    etiquetar_componentes(zonas, componente, tamano);
+
+    // Componente más grande de cada zona
+    std::vector<int> principal(num_zonas, -1);
+    for (std::size_t indice = 0; indice < zonas.size(); ++indice) {
+        int c = componente[indice];
+        int& p = principal[zonas[indice]];
+        if (p < 0 || tamano[c] > tamano[p]) p = c;
+    }
+
+    std::vector<char> fija(zonas.size(), 0);
+    std::vector<int> cola;
+    for (std::size_t indice = 0; indice < zonas.size(); ++indice) {
+        if (componente[indice] == principal[zonas[indice]]) {
+            fija[indice] = 1;
+            cola.push_back(static_cast<int>(indice));
+        }
+    }
+    if (cola.size() == zonas.size()) return; // Ya era conexa
+
+    // Los pedazos sueltos los absorbe la zona vecina que llega primero
+    for (std::size_t frente = 0; frente < cola.size(); ++frente) {
+        int indice = cola[frente];
+        int i = indice / M;
+        int j = indice % M;
+        auto absorber = [&](int vecino) {
+            if (!fija[vecino]) {
+                fija[vecino] = 1;
+                zonas[vecino] = zonas[indice];
+                cola.push_back(vecino);
+            }
+        };
+        if (i > 0) absorber(indice - M);
+        if (i + 1 < N) absorber(indice + M);
+        if (j > 0) absorber(indice - 1);
+        if (j + 1 < M) absorber(indice + 1);
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "spp.hpp"
+
+/**
+ * @class ConectividadZonas
+ * @brief Decide si sacar una celda de su zona la desconecta (4-conectividad).
+ *
+ * Primero mira el anillo de 8 vecinos de la celda: si sus 4-vecinos de la
+ * misma zona están unidos por el anillo, hay un desvío local y la zona sigue
+ * conexa (caso más común, O(1)). Si quedan 2 o más grupos separados en el
+ * anillo, lanza una búsqueda en anchura desde cada grupo a la vez, sin pasar
+ * por la celda: si los frentes se juntan la zona sigue conexa; si un grupo se
+ * agota antes, quedó encerrado. La búsqueda se corta tras `limite_visitas`
+ * celdas y en ese caso se responde "desconecta" (conservador: nunca acepta
+ * un movimiento que rompa una zona, a lo más rechaza alguno válido).
+ *
+ * Guarda buffers de trabajo del tamaño del mapa: usar uno por hilo.
+ */
+class ConectividadZonas {
+public:
+    static constexpr int LIMITE_VISITAS = 4096;
+
+    ConectividadZonas(int filas, int columnas, int limite_visitas = LIMITE_VISITAS);
+
+    /**
+     * @brief true si la celda (i, j) puede dejar su zona sin desconectarla
+     * ni dejarla vacía.
+     */
+    bool puede_salir(const Grid<zona_t>& zonas, int i, int j);
+
+    /**
+     * @brief Solo la prueba del anillo: true si la celda tiene un desvío local
+     * (o es interior). Conservadora, pero no lee más allá de los 8 vecinos,
+     * así que sirve cuando otras partes del mapa cambian en paralelo.
+     */
+    static bool puede_salir_local(const Grid<zona_t>& zonas, int i, int j);
+
+private:
+    int N, M;
+    int limite_visitas;
+    std::vector<std::uint32_t> marca;   // Visitada en la consulta `sello`
+    std::vector<std::uint8_t> grupo;    // Grupo del anillo que la alcanzó
+    std::uint32_t sello;
+    std::vector<int> colas[4];
+
+    // Grupos del anillo de 8 vecinos de (i, j) que contienen un 4-vecino de
+    // su zona (hasta 4, con un representante cada uno); -1 si es interior
+    static int grupos_anillo(const Grid<zona_t>& zonas, int i, int j, int representantes[4]);
+    bool busqueda_acotada(const Grid<zona_t>& zonas, int i, int j, const int* representantes, int num_grupos);
+};
+
+/**
+ * @brief true si cada zona 0..p-1 es 4-conexa (las zonas vacías cuentan como conexas).
+ */
+bool zonas_conexas(const Grid<zona_t>& zonas, int num_zonas);
+
+/**
+ * @brief Hace conexas todas las zonas de `sol`.
+ *
+ * De cada zona se conserva su componente más grande; las celdas de los
+ * demás pedazos se reparten con un BFS multi-fuente a la zona vecina que
+ * las alcance primero. Ninguna zona no vacía queda vacía.
+ */
+void reparar_conectividad(Solucion& sol, int num_zonas);
@@ -0,0 +1,130 @@
+#include "estadisticas.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include <sys/resource.h>
+
+void ContadoresBusqueda::sumar(const ContadoresBusqueda& otros) {
+    evaluaciones_completas += otros.evaluaciones_completas;
+    evaluaciones_delta += otros.evaluaciones_delta;
+    movimientos_probados += otros.movimientos_probados;
+    movimientos_aceptados += otros.movimientos_aceptados;
+    pasadas += otros.pasadas;
+    rechazos_conectividad += otros.rechazos_conectividad;
+}
+
+ContadoresBusqueda& contadores_hilo() {
+    thread_local ContadoresBusqueda contadores;
+    return contadores;
+}
+
+ContadoresBusqueda EstadisticasEjecucion::totales() const {
+    ContadoresBusqueda total;
+    for (const auto& r : restarts) total.sumar(r.contadores);
+    return total;
+}
+
+double EstadisticasEjecucion::tiempo_inicial_total() const {
+    double total = 0.0;
+    for (const auto& r : restarts) total += r.tiempo_inicial;
+    return total;
+}
+
+double EstadisticasEjecucion::tiempo_hc_total() const {
+    double total = 0.0;
+    for (const auto& r : restarts) total += r.tiempo_busqueda;
+    return total;
+}
+
+double memoria_pico_mb() {
+    rusage uso{};
+    if (getrusage(RUSAGE_SELF, &uso) != 0) return 0.0;
+    return uso.ru_maxrss / 1024.0;  // Linux informa ru_maxrss en KB
+}
+
+namespace {
+
+// Sin escapes: los nombres de instancia y estrategia no llevan comillas ni '\'
+std::string texto_json(const std::string& s) {
+    return "\"" + s + "\"";
+}
+
+void escribir_contadores(std::ostream& out, const ContadoresBusqueda& c) {
+    out << "{\"evaluaciones_completas\": " << c.evaluaciones_completas
+        << ", \"evaluaciones_delta\": " << c.evaluaciones_delta
+        << ", \"movimientos_probados\": " << c.movimientos_probados
+        << ", \"movimientos_aceptados\": " << c.movimientos_aceptados
+        << ", \"pasadas\": " << c.pasadas
+        << ", \"rechazos_conectividad\": " << c.rechazos_conectividad << "}";
+}
+
+} // namespace
+
+void EstadisticasEjecucion::escribir_json(std::ostream& out, int sangria) const {
+    std::string pad(sangria, ' ');
+    std::string pad2(sangria + 2, ' ');
+
+    out << "{\n";
+    out << pad2 << "\"instancia\": " << texto_json(instancia) << ",\n";
+    out << pad2 << "\"filas\": " << filas << ",\n";
+    out << pad2 << "\"columnas\": " << columnas << ",\n";
+    out << pad2 << "\"zonas\": " << zonas << ",\n";
+    out << pad2 << "\"alpha\": " << alpha << ",\n";
+    out << pad2 << "\"semilla\": " << semilla << ",\n";
+    out << pad2 << "\"hilos\": " << hilos << ",\n";
+    out << pad2 << "\"estrategia\": " << texto_json(estrategia) << ",\n";
+    out << pad2 << "\"inicial\": " << texto_json(inicial) << ",\n";
+    out << pad2 << "\"motor\": " << texto_json(motor) << ",\n";
+    out << pad2 << "\"costo_final\": " << costo_final << ",\n";
+    out << pad2 << "\"memoria_pico_mb\": " << memoria_pico_mb << ",\n";
+
+    out << pad2 << "\"tiempos\": {\"lectura\": " << tiempo_lectura
+        << ", \"busqueda\": " << tiempo_busqueda
+        << ", \"solucion_inicial_suma\": " << tiempo_inicial_total()
+        << ", \"hill_climbing_suma\": " << tiempo_hc_total() << "},\n";
+
+    out << pad2 << "\"contadores\": ";
+    escribir_contadores(out, totales());
+    out << ",\n";
+
+    out << pad2 << "\"restarts\": [";
+    for (std::size_t k = 0; k < restarts.size(); ++k) {
+        const EstadisticasRestart& r = restarts[k];
+        out << (k ? ",\n" : "\n") << pad2 << "  {\"restart\": " << r.restart
+            << ", \"costo_inicial\": " << r.costo_inicial
+            << ", \"costo_final\": " << r.costo_final
+            << ", \"tiempo_inicial\": " << r.tiempo_inicial
+            << ", \"tiempo_busqueda\": " << r.tiempo_busqueda
+            << ", \"contadores\": ";
+        escribir_contadores(out, r.contadores);
+        out << "}";
+    }
+    out << (restarts.empty() ? "]\n" : "\n" + pad2 + "]\n");
+    out << pad << "}";
+}
+
+void guardar_estadisticas(const std::string& ruta, const std::vector<EstadisticasEjecucion>& ejecuciones) {
+    std::filesystem::path padre = std::filesystem::path(ruta).parent_path();
+    if (!padre.empty()) std::filesystem::create_directories(padre);
+
+    std::ofstream out(ruta);
+    if (!out.is_open()) {
+        throw std::runtime_error("No se pudo escribir el archivo: " + ruta);
+    }
+    out << std::setprecision(10);
+
+    if (ejecuciones.size() == 1) {
+        ejecuciones[0].escribir_json(out);
+    } else {
+        out << "{\"ejecuciones\": [";
+        for (std::size_t k = 0; k < ejecuciones.size(); ++k) {
+            out << (k ? ",\n  " : "\n  ");
+            ejecuciones[k].escribir_json(out, 2);
+        }
+        out << "\n]}";
+    }
+    out << "\n";
+}
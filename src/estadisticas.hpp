@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ContadoresBusqueda
+ * @brief Contadores del camino crítico de una búsqueda local.
+ *
+ * Son enteros planos: cada búsqueda los acumula en variables locales (o en
+ * `EstadoEvaluacion`) y los vuelca al final en `contadores_hilo()`, así que
+ * no hay atómicos ni locks en el bucle interno.
+ *
+ * @var evaluaciones_completas Llamadas a `evaluar_solucion` (O(N*M) cada una).
+ * @var evaluaciones_delta Llamadas a `EstadoEvaluacion::delta_movimiento`.
+ * @var movimientos_probados Vecinos puntuados (deltas, o entradas del kernel por lotes).
+ * @var movimientos_aceptados Movimientos aplicados.
+ * @var pasadas Recorridos de la frontera o del vecindario completo.
+ * @var rechazos_conectividad Celdas descartadas porque su salida desconectaba la zona (--conexo).
+ */
+struct ContadoresBusqueda {
+    long long evaluaciones_completas = 0;
+    long long evaluaciones_delta = 0;
+    long long movimientos_probados = 0;
+    long long movimientos_aceptados = 0;
+    long long pasadas = 0;
+    long long rechazos_conectividad = 0;
+
+    void sumar(const ContadoresBusqueda& otros);
+};
+
+/**
+ * @brief Contadores del hilo actual. El driver de restarts los lee y los
+ * reinicia alrededor de cada restart.
+ */
+ContadoresBusqueda& contadores_hilo();
+
+/**
+ * @struct EstadisticasRestart
+ * @brief Lo medido en un restart: costos, tiempos y contadores.
+ */
+struct EstadisticasRestart {
+    int restart = 0;
+    double costo_inicial = 0.0;
+    double costo_final = 0.0;
+    double tiempo_inicial = 0.0;   // generar_solucion_inicial_aleatoria
+    double tiempo_busqueda = 0.0;  // Hill Climbing
+    ContadoresBusqueda contadores;
+};
+
+/**
+ * @struct EstadisticasEjecucion
+ * @brief Estadísticas de una ejecución completa, para `--stats out.json`.
+ *
+ * `resolver_con_restart` llena `restarts` (ordenados por índice) y
+ * `tiempo_busqueda`; el resto lo completa quien llama (main o el batch).
+ */
+struct EstadisticasEjecucion {
+    std::string instancia;
+    int filas = 0;
+    int columnas = 0;
+    int zonas = 0;
+    double alpha = 0.0;
+    std::uint64_t semilla = 0;
+    int hilos = 1;
+    std::string estrategia;
+    std::string inicial;
+    std::string motor;
+
+    double tiempo_lectura = 0.0;   // I/O: leer_datos
+    double tiempo_busqueda = 0.0;  // resolver_con_restart completo (pared)
+    double costo_final = 0.0;
+    double memoria_pico_mb = 0.0;  // RSS máximo del proceso (0 = no medido; en batch lo comparten todas)
+
+    std::vector<EstadisticasRestart> restarts;
+
+    ContadoresBusqueda totales() const;
+    double tiempo_inicial_total() const;   // Suma sobre restarts (tiempo de CPU de los workers)
+    double tiempo_hc_total() const;
+
+    /**
+     * @brief Escribe el objeto JSON (sin salto de línea final), indentado con `sangria` espacios.
+     */
+    void escribir_json(std::ostream& out, int sangria = 0) const;
+};
+
+/**
+ * @brief Pico de memoria residente (RSS) del proceso hasta ahora, en MB,
+ * según `getrusage`. Devuelve 0 si el sistema no lo informa.
+ */
+double memoria_pico_mb();
+
+/**
+ * @brief Escribe las estadísticas como JSON en `ruta`: el objeto de la
+ * ejecución si hay una sola, o `{"ejecuciones": [...]}` si hay varias (batch).
+ * Lanza std::runtime_error si no puede escribir.
+ */
+void guardar_estadisticas(const std::string& ruta, const std::vector<EstadisticasEjecucion>& ejecuciones);
@@ -0,0 +1,268 @@
+#include "evaluacion_incremental.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Direcciones para vecinos: Arriba, Abajo, Izquierda, Derecha
+const int dr[] = {-1, 1, 0, 0};
+const int dc[] = {0, 0, -1, 1};
+
+/**
+ * @brief Varianza ponderada de una zona de `n` celdas cuyas sumas por banda
+ * son `s + signo * x` y `q + signo * x^2`. Las B varianzas se calculan en un
+ * bucle sin ramas (vectorizable) y se suman después en orden fijo, para que
+ * el resultado no dependa de cómo se vectorice.
+ */
+inline double varianza_bandas(double n, const double* __restrict s, const double* __restrict q,
+                              const double* __restrict x, const double* __restrict pesos, double signo,
+                              int bandas) {
+    double inv = 1.0 / std::max(n, 1.0);
+    double termino[MAX_BANDAS];
+#pragma GCC ivdep
+    for (int b = 0; b < bandas; ++b) {
+        double sb = s[b] + signo * x[b];
+        double qb = q[b] + signo * x[b] * x[b];
+        double media = sb * inv;
+        termino[b] = pesos[b] * std::max(qb * inv - media * media, 0.0);
+    }
+    double varianza = 0.0;
+    for (int b = 0; b < bandas; ++b) varianza += termino[b];
+    return n > 1.0 ? varianza : 0.0; // Varianza de 0 o 1 elemento es 0.
+}
+}
+
+EstadoEvaluacion::EstadoEvaluacion(const Instancia& instancia, Solucion& solucion, double umbral_varianza, bool verificar)
+    : instancia(instancia), solucion(solucion), umbral_varianza(umbral_varianza), verificar(verificar),
+      bandas(instancia.num_bandas()), conteo(instancia.num_zonas, 0),
+      suma(static_cast<std::size_t>(instancia.num_zonas) * bandas, 0.0),
+      suma_cuadrados(static_cast<std::size_t>(instancia.num_zonas) * bandas, 0.0),
+      costo_zona(instancia.num_zonas, 0.0), num_islas(0) {
+
+    for (int b = 0; b < bandas; ++b) planos.push_back(instancia.banda(b).data());
+
+    for (int i = 0; i < instancia.N_filas; ++i) {
+        for (int j = 0; j < instancia.M_columnas; ++j) {
+            int k = solucion.zonas_asignadas(i, j);
+            std::size_t celda = static_cast<std::size_t>(i) * instancia.M_columnas + j;
+            conteo[k] += 1;
+            for (int b = 0; b < bandas; ++b) {
+                double x = planos[b][celda];
+                suma[k * bandas + b] += x;
+                suma_cuadrados[k * bandas + b] += x * x;
+            }
+            if (es_isla(i, j, i, j, k)) num_islas++;
+        }
+    }
+    for (int k = 0; k < instancia.num_zonas; ++k) {
+        costo_zona[k] = bandas == 1 ? costo_de_zona(conteo[k], suma[k], suma_cuadrados[k])
+                                    : costo_de_zona_bandas(conteo[k], &suma[k * bandas], &suma_cuadrados[k * bandas]);
+    }
+}
+
+/**
+ * @brief Varianza de la zona más su penalización de homogeneidad, igual que en
+ * `evaluar_solucion`. Varianza = (1/n) * Sum(x^2) - media^2.
+ */
+double EstadoEvaluacion::costo_de_zona(long long n, double s, double q) const {
+    if (n <= 1) return 0.0; // Varianza de 0 o 1 elemento es 0.
+
+    double media = s / n;
+    double varianza = q / n - media * media;
+    if (varianza < 0.0) varianza = 0.0; // Cancelación numérica
+
+    return costo_de_varianza(varianza);
+}
+
+double EstadoEvaluacion::costo_de_varianza(double varianza) const {
+    double costo = varianza;
+    if (varianza > umbral_varianza) {
+        costo += (varianza - umbral_varianza) * PENALIZACION_HOMOGENEIDAD;
+    }
+    return costo;
+}
+
+double EstadoEvaluacion::costo_de_zona_bandas(long long n, const double* s, const double* q) const {
+    const double cero[MAX_BANDAS] = {};
+    return costo_de_varianza(varianza_bandas(static_cast<double>(n), s, q, cero, instancia.pesos.data(), 0.0, bandas));
+}
+
+/**
+ * @brief Costo de la zona multibanda `zona` si gana (`signo = 1`) o pierde
+ * (`signo = -1`) una celda con valores `x` (uno por banda).
+ */
+double EstadoEvaluacion::costo_movido(int zona, const double* x, double signo) const {
+    double n = static_cast<double>(conteo[zona]) + signo;
+    return costo_de_varianza(varianza_bandas(n, &suma[zona * bandas], &suma_cuadrados[zona * bandas], x,
+                                             instancia.pesos.data(), signo, bandas));
+}
+
+void EstadoEvaluacion::mover_bandas(int zona, const double* x, double signo) {
+    conteo[zona] += static_cast<long long>(signo);
+    double* s = &suma[zona * bandas];
+    double* q = &suma_cuadrados[zona * bandas];
+    for (int b = 0; b < bandas; ++b) {
+        s[b] += signo * x[b];
+        q[b] += signo * x[b] * x[b];
+    }
+    costo_zona[zona] = costo_de_zona_bandas(conteo[zona], s, q);
+}
+
+double EstadoEvaluacion::costo() const {
+    double total = 0.0;
+    for (double c : costo_zona) total += c;
+    return total + num_islas * M_ISLA;
+}
+
+bool EstadoEvaluacion::penalizada() const {
+    if (num_islas > 0) return true;
+    for (int k = 0; k < instancia.num_zonas; ++k) {
+        if (conteo[k] > 1 && bandas > 1) {
+            const double cero[MAX_BANDAS] = {};
+            double varianza = varianza_bandas(static_cast<double>(conteo[k]), &suma[k * bandas],
+                                              &suma_cuadrados[k * bandas], cero, instancia.pesos.data(), 0.0, bandas);
+            if (varianza > umbral_varianza) return true;
+        } else if (conteo[k] > 1) {
+            double media = suma[k] / conteo[k];
+            if (suma_cuadrados[k] / conteo[k] - media * media > umbral_varianza) return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief ¿Es isla la celda (ci, cj) si la celda (i, j) tuviera la zona `zona_ij`?
+ * Permite evaluar el estado "después" de un movimiento sin tocar la solución.
+ */
+bool EstadoEvaluacion::es_isla(int ci, int cj, int i, int j, int zona_ij) const {
+    auto zona_en = [&](int r, int c) {
+        return (r == i && c == j) ? zona_ij : static_cast<int>(solucion.zonas_asignadas(r, c));
+    };
+
+    int mi_zona = zona_en(ci, cj);
+    int vecinos_validos = 0;
+    for (int d = 0; d < 4; ++d) {
+        int ni = ci + dr[d];
+        int nj = cj + dc[d];
+        if (ni >= 0 && ni < instancia.N_filas && nj >= 0 && nj < instancia.M_columnas) {
+            vecinos_validos++;
+            if (zona_en(ni, nj) == mi_zona) return false;
+        }
+    }
+    // Si tengo vecinos, pero NINGUNO es de mi zona -> SOY UNA ISLA
+    return vecinos_validos > 0;
+}
+
+/**
+ * @brief Islas entre la celda (i, j) y sus 4 vecinos (las únicas celdas cuyo
+ * estado de isla puede cambiar al reasignar (i, j)), con (i, j) en `zona_ij`.
+ */
+int EstadoEvaluacion::islas_locales(int i, int j, int zona_ij) const {
+    int total = es_isla(i, j, i, j, zona_ij) ? 1 : 0;
+    for (int d = 0; d < 4; ++d) {
+        int ni = i + dr[d];
+        int nj = j + dc[d];
+        if (ni >= 0 && ni < instancia.N_filas && nj >= 0 && nj < instancia.M_columnas) {
+            if (es_isla(ni, nj, i, j, zona_ij)) total++;
+        }
+    }
+    return total;
+}
+
+int EstadoEvaluacion::delta_islas(int i, int j, int zona_destino) const {
+    int zona_origen = solucion.zonas_asignadas(i, j);
+    if (zona_origen == zona_destino) return 0;
+    return islas_locales(i, j, zona_destino) - islas_locales(i, j, zona_origen);
+}
+
+double EstadoEvaluacion::delta_movimiento(int i, int j, int zona_destino) {
+    ++cuenta.evaluaciones_delta;
+    int zona_origen = solucion.zonas_asignadas(i, j);
+    if (zona_origen == zona_destino) return 0.0;
+
+    double nuevo_origen, nuevo_destino;
+    if (bandas == 1) {
+        double x = instancia.datos_terreno(i, j);
+        nuevo_origen = costo_de_zona(conteo[zona_origen] - 1, suma[zona_origen] - x,
+                                     suma_cuadrados[zona_origen] - x * x);
+        nuevo_destino = costo_de_zona(conteo[zona_destino] + 1, suma[zona_destino] + x,
+                                      suma_cuadrados[zona_destino] + x * x);
+    } else {
+        std::size_t celda = static_cast<std::size_t>(i) * instancia.M_columnas + j;
+        double x[MAX_BANDAS];
+        for (int b = 0; b < bandas; ++b) x[b] = planos[b][celda];
+        nuevo_origen = costo_movido(zona_origen, x, -1.0);
+        nuevo_destino = costo_movido(zona_destino, x, 1.0);
+    }
+    double delta = (nuevo_origen - costo_zona[zona_origen]) + (nuevo_destino - costo_zona[zona_destino]);
+
+    // Las islas solo pueden cambiar en la celda movida y su 4-vecindad
+    delta += delta_islas(i, j, zona_destino) * M_ISLA;
+
+    if (verificar) {
+        solucion.zonas_asignadas(i, j) = zona_destino;
+        double esperado = evaluar_solucion(instancia, solucion, umbral_varianza);
+        solucion.zonas_asignadas(i, j) = zona_origen;
+
+        double obtenido = costo() + delta;
+        double tolerancia = 1e-6 * std::max(1.0, std::fabs(esperado));
+        if (std::fabs(esperado - obtenido) > tolerancia) {
+            throw std::runtime_error("Delta inconsistente en celda (" + std::to_string(i) + ", " + std::to_string(j) +
+                                     ") -> zona " + std::to_string(zona_destino) + ": evaluar_solucion = " +
+                                     std::to_string(esperado) + ", incremental = " + std::to_string(obtenido));
+        }
+    }
+
+    return delta;
+}
+
+void EstadoEvaluacion::sumar_cambios(const long long* conteo_delta, const double* suma_delta,
+                                     const double* cuadrados_delta, int islas_delta, long long movimientos,
+                                     int signo) {
+    if (bandas != 1) {
+        throw std::runtime_error("sumar_cambios solo admite instancias de una banda");
+    }
+    for (int k = 0; k < instancia.num_zonas; ++k) {
+        // Conteo y suma pueden anularse sin que se anule la suma de cuadrados
+        // (entran {1, 5} y salen {3, 3}): solo se salta si los tres son cero
+        if (conteo_delta[k] == 0 && suma_delta[k] == 0.0 && cuadrados_delta[k] == 0.0) continue;
+        conteo[k] += signo * conteo_delta[k];
+        suma[k] += signo * suma_delta[k];
+        suma_cuadrados[k] += signo * cuadrados_delta[k];
+        costo_zona[k] = costo_de_zona(conteo[k], suma[k], suma_cuadrados[k]);
+    }
+    num_islas += signo * islas_delta;
+    cuenta.movimientos_aceptados += signo * movimientos;
+}
+
+void EstadoEvaluacion::aplicar_movimiento(int i, int j, int zona_destino) {
+    int zona_origen = solucion.zonas_asignadas(i, j);
+    if (zona_origen == zona_destino) return;
+    ++cuenta.movimientos_aceptados;
+
+    num_islas += delta_islas(i, j, zona_destino);
+    solucion.zonas_asignadas(i, j) = zona_destino;
+
+    if (bandas > 1) {
+        std::size_t celda = static_cast<std::size_t>(i) * instancia.M_columnas + j;
+        double x[MAX_BANDAS];
+        for (int b = 0; b < bandas; ++b) x[b] = planos[b][celda];
+        mover_bandas(zona_origen, x, -1.0);
+        mover_bandas(zona_destino, x, 1.0);
+        return;
+    }
+
+    double x = instancia.datos_terreno(i, j);
+
+    conteo[zona_origen] -= 1;
+    suma[zona_origen] -= x;
+    suma_cuadrados[zona_origen] -= x * x;
+    conteo[zona_destino] += 1;
+    suma[zona_destino] += x;
+    suma_cuadrados[zona_destino] += x * x;
+
+    costo_zona[zona_origen] = costo_de_zona(conteo[zona_origen], suma[zona_origen], suma_cuadrados[zona_origen]);
+    costo_zona[zona_destino] = costo_de_zona(conteo[zona_destino], suma[zona_destino], suma_cuadrados[zona_destino]);
+}
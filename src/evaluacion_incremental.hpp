@@ -0,0 +1,122 @@
+#pragma once
+
+#include <vector>
+#include "spp.hpp"
+#include "estadisticas.hpp"
+
+/**
+ * @class EstadoEvaluacion
+ * @brief Estado persistente de la función objetivo para evaluar movimientos en O(1).
+ *
+ * Mantiene, para cada zona, el conteo, la suma y la suma de cuadrados de sus
+ * valores, junto con el número de islas de la solución. Con eso, el costo de
+ * reasignar la celda (i, j) de la zona a a la zona b se obtiene mirando solo
+ * esas dos zonas y la 4-vecindad de la celda, sin recorrer todo el mapa como
+ * hace `evaluar_solucion`.
+ *
+ * Con una instancia multibanda las sumas se guardan por zona y banda
+ * (`suma[zona * B + banda]`, las B bandas de una zona contiguas) y el costo
+ * de la zona es la varianza ponderada entre bandas: el delta de un
+ * movimiento recorre las B bandas de las dos zonas en un bucle sin ramas que
+ * el compilador vectoriza, así que crece poco con B.
+ *
+ * El estado guarda una referencia a la `Solucion`: los movimientos deben
+ * hacerse con `aplicar_movimiento` para que ambos se mantengan sincronizados.
+ *
+ * En modo verificación (`verificar = true`) cada delta se contrasta con
+ * `evaluar_solucion` completo y se lanza std::runtime_error si no coinciden.
+ * Es carísimo; solo sirve para depurar.
+ */
+class EstadoEvaluacion {
+public:
+    EstadoEvaluacion(const Instancia& instancia, Solucion& solucion, double umbral_varianza, bool verificar = false);
+
+    /**
+     * @brief Costo actual (mismo valor que `evaluar_solucion`, salvo redondeo).
+     */
+    double costo() const;
+
+    /**
+     * @brief Cambio exacto del costo si la celda (i, j) pasa a `zona_destino`.
+     * No modifica la solución.
+     */
+    double delta_movimiento(int i, int j, int zona_destino);
+
+    /**
+     * @brief Reasigna la celda (i, j) a `zona_destino` y actualiza el estado.
+     */
+    void aplicar_movimiento(int i, int j, int zona_destino);
+
+    /**
+     * @brief Cambio en el número de islas si (i, j) pasa a `zona_destino`.
+     * Solo lee la solución, así que puede llamarse desde varios hilos.
+     */
+    int delta_islas(int i, int j, int zona_destino) const;
+
+    int islas() const { return num_islas; }
+
+    // Estadísticas por zona, para los kernels que puntúan movimientos en lote
+    // (con varias bandas, `sumas()` y `sumas_cuadrados()` tienen B entradas por zona)
+    const std::vector<long long>& conteos() const { return conteo; }
+    const std::vector<double>& sumas() const { return suma; }
+    const std::vector<double>& sumas_cuadrados() const { return suma_cuadrados; }
+    const std::vector<double>& costos_zona() const { return costo_zona; }
+    double umbral() const { return umbral_varianza; }
+
+    /**
+     * @brief Varianza más penalización de homogeneidad de una zona con `n`
+     * celdas, suma `s` y suma de cuadrados `q`. No depende del estado.
+     */
+    double costo_de_zona(long long n, double s, double q) const;
+
+    /**
+     * @brief Costo (varianza ponderada más penalización) de una zona
+     * multibanda con `n` celdas y sumas por banda `s` y `q` (B entradas).
+     */
+    double costo_de_zona_bandas(long long n, const double* s, const double* q) const;
+
+    int num_bandas() const { return bandas; }
+
+    /**
+     * @brief Incorpora cambios que se escribieron directo en la solución, sin
+     * pasar por `aplicar_movimiento` (ej. las teselas de `hill_climbing_teselas`):
+     * deltas por zona de conteo, suma y suma de cuadrados, más el cambio en
+     * islas y los movimientos que los produjeron. `signo = -1` los revierte.
+     * Solo con una banda (lanza std::runtime_error si hay más).
+     */
+    void sumar_cambios(const long long* conteo_delta, const double* suma_delta, const double* cuadrados_delta,
+                       int islas_delta, long long movimientos, int signo = 1);
+
+    /**
+     * @brief true si la solución paga alguna penalización (islas o zonas
+     * sobre el umbral de homogeneidad).
+     */
+    bool penalizada() const;
+
+    /**
+     * @brief Contadores de esta búsqueda. El estado cuenta deltas y movimientos
+     * aplicados; el Hill Climbing agrega vecinos probados y pasadas.
+     */
+    ContadoresBusqueda& contadores() { return cuenta; }
+
+private:
+    const Instancia& instancia;
+    Solucion& solucion;
+    double umbral_varianza;
+    bool verificar;
+
+    int bandas;
+    std::vector<const float*> planos;     // Un plano contiguo por banda
+    std::vector<long long> conteo;        // Celdas por zona
+    std::vector<double> suma;             // Suma de valores por zona (y banda)
+    std::vector<double> suma_cuadrados;   // Suma de valores^2 por zona (y banda)
+    std::vector<double> costo_zona;       // Varianza + penalización de homogeneidad por zona
+    int num_islas;
+    ContadoresBusqueda cuenta;
+
+    double costo_de_varianza(double varianza) const;
+    double costo_movido(int zona, const double* x, double signo) const;
+    void mover_bandas(int zona, const double* x, double signo);
+    bool es_isla(int ci, int cj, int i, int j, int zona_ij) const;
+    int islas_locales(int i, int j, int zona_ij) const;
+};
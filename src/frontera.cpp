@@ -0,0 +1,84 @@
+#include "frontera.hpp"
+
+namespace {
+// Direcciones para vecinos: Arriba, Abajo, Izquierda, Derecha
+const int dr[] = {-1, 1, 0, 0};
+const int dc[] = {0, 0, -1, 1};
+}
+
+FronteraZonas::FronteraZonas(const Grid<zona_t>& zonas)
+    : zonas(zonas), posicion(zonas.size(), -1) {
+    for (int i = 0; i < zonas.filas(); ++i) {
+        for (int j = 0; j < zonas.columnas(); ++j) {
+            if (es_frontera(zonas, i, j)) {
+                int indice = i * zonas.columnas() + j;
+                posicion[indice] = static_cast<int>(lista.size());
+                lista.push_back(indice);
+            }
+        }
+    }
+}
+
+bool FronteraZonas::es_frontera(const Grid<zona_t>& zonas, int i, int j) {
+    zona_t mi_zona = zonas(i, j);
+    for (int d = 0; d < 4; ++d) {
+        int ni = i + dr[d];
+        int nj = j + dc[d];
+        if (ni >= 0 && ni < zonas.filas() && nj >= 0 && nj < zonas.columnas()) {
+            if (zonas(ni, nj) != mi_zona) return true;
+        }
+    }
+    return false;
+}
+
+int FronteraZonas::zonas_vecinas(const Grid<zona_t>& zonas, int i, int j, zona_t salida[4]) {
+    zona_t mi_zona = zonas(i, j);
+    int total = 0;
+    for (int d = 0; d < 4; ++d) {
+        int ni = i + dr[d];
+        int nj = j + dc[d];
+        if (ni < 0 || ni >= zonas.filas() || nj < 0 || nj >= zonas.columnas()) continue;
+
+        zona_t z = zonas(ni, nj);
+        if (z == mi_zona) continue;
+
+        bool repetida = false;
+        for (int k = 0; k < total; ++k) {
+            if (salida[k] == z) {
+                repetida = true;
+                break;
+            }
+        }
+        if (!repetida) salida[total++] = z;
+    }
+    return total;
+}
+
+void FronteraZonas::actualizar(int i, int j) {
+    int indice = i * zonas.columnas() + j;
+    bool dentro = es_frontera(zonas, i, j);
+
+    if (dentro && posicion[indice] < 0) {
+        posicion[indice] = static_cast<int>(lista.size());
+        lista.push_back(indice);
+    } else if (!dentro && posicion[indice] >= 0) {
+        // Borrado O(1): el último ocupa el hueco
+        int hueco = posicion[indice];
+        int ultimo = lista.back();
+        lista[hueco] = ultimo;
+        posicion[ultimo] = hueco;
+        lista.pop_back();
+        posicion[indice] = -1;
+    }
+}
+
+void FronteraZonas::actualizar_alrededor(int i, int j) {
+    actualizar(i, j);
+    for (int d = 0; d < 4; ++d) {
+        int ni = i + dr[d];
+        int nj = j + dc[d];
+        if (ni >= 0 && ni < zonas.filas() && nj >= 0 && nj < zonas.columnas()) {
+            actualizar(ni, nj);
+        }
+    }
+}
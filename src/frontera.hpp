@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include "grid.hpp"
+
+/**
+ * @class FronteraZonas
+ * @brief Conjunto de celdas de frontera (con algún 4-vecino de otra zona).
+ *
+ * Solo una celda de frontera puede cambiar de zona sin quedar como isla, así
+ * que el vecindario del Hill Climbing se restringe a estas celdas y a las
+ * zonas de sus vecinos. El conjunto se mantiene de forma incremental: tras
+ * mover la celda (i, j) basta con `actualizar_alrededor(i, j)`, que revisa la
+ * celda y su 4-vecindad.
+ *
+ * Las celdas se identifican por su índice lineal i * M + j.
+ */
+class FronteraZonas {
+public:
+    explicit FronteraZonas(const Grid<zona_t>& zonas);
+
+    bool contiene(int indice) const { return posicion[indice] >= 0; }
+    const std::vector<int>& celdas() const { return lista; }
+
+    /**
+     * @brief Recalcula la pertenencia de (i, j) y sus 4 vecinos tras un movimiento.
+     */
+    void actualizar_alrededor(int i, int j);
+
+    /**
+     * @brief Escribe en `salida` las zonas distintas de los 4-vecinos de (i, j)
+     * que no son la zona de la celda. Devuelve cuántas escribió (0 a 4).
+     */
+    static int zonas_vecinas(const Grid<zona_t>& zonas, int i, int j, zona_t salida[4]);
+
+    static bool es_frontera(const Grid<zona_t>& zonas, int i, int j);
+
+private:
+    const Grid<zona_t>& zonas;
+    std::vector<int> lista;      // Celdas de frontera, sin orden particular
+    std::vector<int> posicion;   // Posición de cada celda en `lista`, o -1
+
+    void actualizar(int i, int j);
+};
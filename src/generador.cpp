@@ -0,0 +1,234 @@
+/**
+ * @file generador.cpp
+ * @brief Generador de terrenos sintéticos (`make generador`).
+ *
+ * Escribe un mapa de `filas x columnas` con ruido fractal: suma de
+ * `octavas` capas de ruido de Perlin, cada una con el doble de frecuencia y
+ * `persistencia` veces la amplitud de la anterior. `escala` es el largo de
+ * onda (en celdas) de la capa más gruesa, es decir, el largo de correlación
+ * espacial: con escala grande salen pocas regiones amplias y suaves; con
+ * escala chica, muchas manchas pequeñas. Una persistencia alta da relieve
+ * más rugoso. Opcionalmente se suma ruido blanco uniforme de amplitud `ruido`.
+ *
+ * El resultado depende solo de los argumentos (incluida la semilla): la
+ * permutación y los desplazamientos se sacan de `generador_para` sin pasar
+ * por distribuciones de la biblioteca estándar, así que el mismo comando da
+ * el mismo archivo en cualquier plataforma.
+ *
+ * Uso:
+ *     ./spp_generador <salida.spp|salida.sppb> <filas> [columnas]
+ *                     [--semilla S] [--escala CELDAS] [--octavas K]
+ *                     [--persistencia H] [--ruido R] [--rango MIN MAX]
+ *
+ * La extensión decide el formato: `.sppb` escribe el binario que el solver
+ * mapea sin copiar (lo recomendable sobre 1000x1000), cualquier otra escribe
+ * texto con dos decimales.
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "spp.hpp"
+
+namespace {
+
+/**
+ * @struct ParametrosTerreno
+ * @var escala Largo de onda de la primera octava en celdas (0 = un cuarto del lado mayor).
+ */
+struct ParametrosTerreno {
+    std::uint64_t semilla = 1;
+    double escala = 0.0;
+    int octavas = 6;
+    double persistencia = 0.5;
+    double ruido = 0.0;
+    double minimo = 0.0;
+    double maximo = 100.0;
+};
+
+/**
+ * @brief Ruido de Perlin 2D clásico: gradientes en los vértices de la grilla
+ * entera, elegidos por una permutación de 256, e interpolación quíntica.
+ * Devuelve valores en [-1, 1] aproximadamente.
+ */
+class RuidoPerlin {
+public:
+    explicit RuidoPerlin(std::mt19937& gen) {
+        for (int k = 0; k < 256; ++k) perm_[k] = static_cast<std::uint8_t>(k);
+        // Fisher-Yates a mano: std::shuffle no da lo mismo en todas las bibliotecas
+        for (int k = 255; k > 0; --k) {
+            int otro = static_cast<int>(gen() % static_cast<std::uint32_t>(k + 1));
+            std::swap(perm_[k], perm_[otro]);
+        }
+        for (int k = 0; k < 256; ++k) perm_[k + 256] = perm_[k];
+    }
+
+    double operator()(double x, double y) const {
+        double fx = std::floor(x), fy = std::floor(y);
+        int xi = static_cast<int>(fx) & 255;
+        int yi = static_cast<int>(fy) & 255;
+        double dx = x - fx, dy = y - fy;
+        double u = suavizar(dx), v = suavizar(dy);
+
+        int a = perm_[xi] + yi, b = perm_[xi + 1] + yi;
+        double n00 = gradiente(perm_[a], dx, dy);
+        double n10 = gradiente(perm_[b], dx - 1.0, dy);
+        double n01 = gradiente(perm_[a + 1], dx, dy - 1.0);
+        double n11 = gradiente(perm_[b + 1], dx - 1.0, dy - 1.0);
+
+        double abajo = n00 + u * (n10 - n00);
+        double arriba = n01 + u * (n11 - n01);
+        return abajo + v * (arriba - abajo);
+    }
+
+private:
+    std::array<std::uint8_t, 512> perm_{};
+
+    static double suavizar(double t) { return t * t * t * (t * (t * 6.0 - 15.0) + 10.0); }
+
+    // Uno de 8 gradientes (ejes y diagonales) según el hash
+    static double gradiente(int hash, double x, double y) {
+        switch (hash & 7) {
+            case 0: return x + y;
+            case 1: return x - y;
+            case 2: return -x + y;
+            case 3: return -x - y;
+            case 4: return x;
+            case 5: return -x;
+            case 6: return y;
+            default: return -y;
+        }
+    }
+};
+
+// Uniforme en [0, 1) a partir de 32 bits crudos del generador
+double uniforme(std::mt19937& gen) {
+    return gen() / 4294967296.0;
+}
+
+/**
+ * @brief Terreno fractal (fBm de Perlin) reescalado a [minimo, maximo].
+ */
+Grid<float> generar_terreno(int filas, int columnas, const ParametrosTerreno& p) {
+    std::mt19937 gen = generador_para(p.semilla, 0);
+    RuidoPerlin perlin(gen);
+
+    const double escala = p.escala > 0.0 ? p.escala : std::max(filas, columnas) / 4.0;
+
+    // Cada octava se desplaza al azar para que no coincidan sus vértices en (0, 0)
+    std::vector<double> desplazamiento(2 * static_cast<std::size_t>(p.octavas));
+    for (double& d : desplazamiento) d = uniforme(gen) * 256.0;
+
+    std::vector<double> crudo(static_cast<std::size_t>(filas) * columnas);
+    double menor = std::numeric_limits<double>::infinity();
+    double mayor = -std::numeric_limits<double>::infinity();
+    for (int i = 0; i < filas; ++i) {
+        for (int j = 0; j < columnas; ++j) {
+            double frecuencia = 1.0 / escala, amplitud = 1.0, suma = 0.0;
+            for (int o = 0; o < p.octavas; ++o) {
+                suma += amplitud * perlin(i * frecuencia + desplazamiento[2 * o], j * frecuencia + desplazamiento[2 * o + 1]);
+                frecuencia *= 2.0;
+                amplitud *= p.persistencia;
+            }
+            crudo[static_cast<std::size_t>(i) * columnas + j] = suma;
+            menor = std::min(menor, suma);
+            mayor = std::max(mayor, suma);
+        }
+    }
+
+    const double rango = mayor > menor ? mayor - menor : 1.0;
+    Grid<float> datos(filas, columnas);
+    for (std::size_t idx = 0; idx < crudo.size(); ++idx) {
+        double valor = p.minimo + (crudo[idx] - menor) / rango * (p.maximo - p.minimo);
+        if (p.ruido > 0.0) valor += (2.0 * uniforme(gen) - 1.0) * p.ruido;
+        datos[idx] = static_cast<float>(valor);
+    }
+    return datos;
+}
+
+void mostrar_uso(const char* programa) {
+    std::cerr << "Uso: " << programa << " <salida.spp|salida.sppb> <filas> [columnas]" << std::endl;
+    std::cerr << "       [--semilla S] [--escala CELDAS] [--octavas K] [--persistencia H]"
+              << " [--ruido R] [--rango MIN MAX]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        mostrar_uso(argv[0]);
+        return 1;
+    }
+
+    std::string salida = argv[1];
+    ParametrosTerreno parametros;
+    int filas = 0, columnas = 0;
+
+    try {
+        filas = std::stoi(argv[2]);
+        columnas = filas;
+        int i = 3;
+        if (i < argc && argv[i][0] != '-') columnas = std::stoi(argv[i++]);
+
+        for (; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hay_valor = (i + 1 < argc);
+            if (arg == "--semilla" && hay_valor) {
+                parametros.semilla = std::stoull(argv[++i]);
+            } else if (arg == "--escala" && hay_valor) {
+                parametros.escala = std::stod(argv[++i]);
+            } else if (arg == "--octavas" && hay_valor) {
+                parametros.octavas = std::stoi(argv[++i]);
+            } else if (arg == "--persistencia" && hay_valor) {
+                parametros.persistencia = std::stod(argv[++i]);
+            } else if (arg == "--ruido" && hay_valor) {
+                parametros.ruido = std::stod(argv[++i]);
+            } else if (arg == "--rango" && i + 2 < argc) {
+                parametros.minimo = std::stod(argv[++i]);
+                parametros.maximo = std::stod(argv[++i]);
+            } else {
+                mostrar_uso(argv[0]);
+                return 1;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Error: argumento numerico invalido" << std::endl;
+        return 1;
+    }
+
+    if (filas <= 0 || columnas <= 0) {
+        std::cerr << "Error: filas y columnas deben ser positivas" << std::endl;
+        return 1;
+    }
+    if (parametros.octavas < 1 || parametros.escala < 0.0 || parametros.persistencia <= 0.0 ||
+        parametros.ruido < 0.0 || parametros.maximo < parametros.minimo) {
+        std::cerr << "Error: se requiere octavas >= 1, escala >= 0, persistencia > 0, ruido >= 0 y MIN <= MAX"
+                  << std::endl;
+        return 1;
+    }
+
+    try {
+        Grid<float> datos = generar_terreno(filas, columnas, parametros);
+        std::filesystem::path padre = std::filesystem::path(salida).parent_path();
+        if (!padre.empty()) std::filesystem::create_directories(padre);
+        if (std::filesystem::path(salida).extension() == ".sppb") {
+            escribir_sppb(salida, datos);
+        } else {
+            escribir_spp(salida, datos);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Terreno " << filas << "x" << columnas << " escrito en: " << salida << std::endl;
+    return 0;
+}
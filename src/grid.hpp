@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @class Grid
+ * @brief Matriz (N x M) almacenada por filas en un único bloque contiguo.
+ *
+ * Reemplaza a `std::vector<std::vector<T>>`: copiarla es una sola reserva de
+ * memoria y acceder a (i, j) es un cálculo de índice, sin saltar entre filas.
+ * `data()` expone el buffer para envolverlo directamente (ej. en un cv::Mat).
+ *
+ * Además de su propio buffer, una Grid puede ser una vista sobre memoria
+ * externa (ej. un archivo .sppb mapeado con mmap), que se mantiene viva con
+ * `dueno`. Copiar una vista produce una Grid con buffer propio; moverla no
+ * copia nada.
+ */
+template <typename T>
+class Grid {
+public:
+    Grid() : n_filas(0), n_columnas(0), ptr(nullptr) {}
+
+    Grid(int filas, int columnas, const T& valor = T())
+        : n_filas(filas), n_columnas(columnas),
+          celdas(static_cast<std::size_t>(filas) * columnas, valor), ptr(celdas.data()) {}
+
+    /**
+     * @brief Vista sin copia sobre `datos` (filas x columnas, por filas).
+     * `dueno` mantiene viva la memoria mientras exista la Grid.
+     */
+    static Grid vista(int filas, int columnas, T* datos, std::shared_ptr<const void> dueno) {
+        Grid g;
+        g.n_filas = filas;
+        g.n_columnas = columnas;
+        g.ptr = datos;
+        g.dueno = std::move(dueno);
+        return g;
+    }
+
+    Grid(const Grid& otra)
+        : n_filas(otra.n_filas), n_columnas(otra.n_columnas),
+          celdas(otra.begin(), otra.end()), ptr(celdas.data()) {}
+
+    Grid(Grid&& otra) noexcept { tomar(std::move(otra)); }
+
+    Grid& operator=(const Grid& otra) {
+        if (this != &otra) {
+            n_filas = otra.n_filas;
+            n_columnas = otra.n_columnas;
+            celdas.assign(otra.begin(), otra.end());
+            ptr = celdas.data();
+            dueno.reset();
+        }
+        return *this;
+    }
+
+    Grid& operator=(Grid&& otra) noexcept {
+        if (this != &otra) tomar(std::move(otra));
+        return *this;
+    }
+
+    T& operator()(int i, int j) { return ptr[static_cast<std::size_t>(i) * n_columnas + j]; }
+    const T& operator()(int i, int j) const { return ptr[static_cast<std::size_t>(i) * n_columnas + j]; }
+
+    T& operator[](std::size_t indice) { return ptr[indice]; }
+    const T& operator[](std::size_t indice) const { return ptr[indice]; }
+
+    T* fila(int i) { return ptr + static_cast<std::size_t>(i) * n_columnas; }
+    const T* fila(int i) const { return ptr + static_cast<std::size_t>(i) * n_columnas; }
+
+    T* data() { return ptr; }
+    const T* data() const { return ptr; }
+
+    int filas() const { return n_filas; }
+    int columnas() const { return n_columnas; }
+    std::size_t size() const { return static_cast<std::size_t>(n_filas) * n_columnas; }
+    bool empty() const { return size() == 0; }
+
+    T* begin() { return ptr; }
+    T* end() { return ptr + size(); }
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + size(); }
+
+private:
+    int n_filas;
+    int n_columnas;
+    std::vector<T> celdas;               // Buffer propio (vacío si es una vista)
+    T* ptr;                              // celdas.data() o memoria externa
+    std::shared_ptr<const void> dueno;   // Mantiene viva la memoria externa
+
+    void tomar(Grid&& otra) {
+        n_filas = otra.n_filas;
+        n_columnas = otra.n_columnas;
+        bool es_vista = static_cast<bool>(otra.dueno);
+        celdas = std::move(otra.celdas);
+        ptr = es_vista ? otra.ptr : celdas.data();
+        dueno = std::move(otra.dueno);
+
+        otra.n_filas = otra.n_columnas = 0;
+        otra.celdas.clear();
+        otra.ptr = nullptr;
+    }
+};
+
+/**
+ * @brief Tipo de las etiquetas de zona. 16 bits alcanzan para p <= 65535 zonas
+ * y ocupan la mitad que un int (menos tráfico de caché en mapas grandes).
+ */
+using zona_t = std::uint16_t;
+constexpr int MAX_ZONAS = 65535;
@@ -1,29 +1,99 @@
 #include <opencv2/opencv.hpp>
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 #include <string> // Para std::to_string
 
-void plotHeatmap(const std::vector<std::vector<float>>& M, int factor, const std::vector<std::vector<int>>& Z = {}, bool showLabels = false) {
-    int rows = M.size();
-    int cols = M[0].size();
-    cv::Mat matM(rows, cols, CV_32F);
-    
-    for(int i = 0; i < rows; ++i) {
-        for(int j = 0; j < cols; ++j) {
-            matM.at<float>(i,j) = M[i][j];
+#include "spp.hpp"
+
+namespace {
+
+// Lado máximo (en píxeles) de la imagen; en mapas grandes se reduce el factor
+constexpr int LADO_MAXIMO_IMAGEN = 4000;
+
+// Borde de cada zona: celdas cuyo vecino derecho o inferior es de otra zona.
+// Se compara Z_big contra sí misma desplazada una columna y una fila.
+cv::Mat bordes_zonas(const cv::Mat& Z_big) {
+    cv::Mat borde = cv::Mat::zeros(Z_big.size(), CV_8U);
+    cv::Mat distinto;
+    if (Z_big.cols > 1) {
+        cv::compare(Z_big.colRange(0, Z_big.cols - 1), Z_big.colRange(1, Z_big.cols), distinto, cv::CMP_NE);
+        distinto.copyTo(borde.colRange(0, Z_big.cols - 1));
+    }
+    if (Z_big.rows > 1) {
+        cv::Mat abajo = borde.rowRange(0, Z_big.rows - 1);
+        cv::compare(Z_big.rowRange(0, Z_big.rows - 1), Z_big.rowRange(1, Z_big.rows), distinto, cv::CMP_NE);
+        cv::bitwise_or(abajo, distinto, abajo);
+    }
+    return borde;
+}
+
+// Una etiqueta por zona, en la celda de la zona más cercana a su centroide
+// (el centroide de una zona no convexa puede caer fuera de ella)
+void dibujar_etiquetas(cv::Mat& imagen, const cv::Mat& matZ, int factor) {
+    double max_zona = 0.0;
+    cv::minMaxLoc(matZ, nullptr, &max_zona);
+    int num_ids = static_cast<int>(max_zona) + 1;
+
+    std::vector<double> suma_i(num_ids, 0.0), suma_j(num_ids, 0.0);
+    std::vector<long long> conteo(num_ids, 0);
+    for (int i = 0; i < matZ.rows; ++i) {
+        const int* fila = matZ.ptr<int>(i);
+        for (int j = 0; j < matZ.cols; ++j) {
+            if (fila[j] < 0) continue;
+            suma_i[fila[j]] += i;
+            suma_j[fila[j]] += j;
+            ++conteo[fila[j]];
         }
     }
-    
-    cv::Mat matZ;
-    if (!Z.empty()) {
-        matZ = cv::Mat(rows, cols, CV_32S);
-        for(int i = 0; i < rows; ++i) {
-            for(int j = 0; j < cols; ++j) {
-                matZ.at<int>(i,j) = Z[i][j];
+
+    std::vector<double> mejor_distancia(num_ids, std::numeric_limits<double>::infinity());
+    std::vector<cv::Point> celda(num_ids);
+    for (int i = 0; i < matZ.rows; ++i) {
+        const int* fila = matZ.ptr<int>(i);
+        for (int j = 0; j < matZ.cols; ++j) {
+            int z = fila[j];
+            if (z < 0) continue;
+            double di = i - suma_i[z] / conteo[z];
+            double dj = j - suma_j[z] / conteo[z];
+            double distancia = di * di + dj * dj;
+            if (distancia < mejor_distancia[z]) {
+                mejor_distancia[z] = distancia;
+                celda[z] = cv::Point(j, i);
             }
         }
     }
-    
+
+    // Con una etiqueta por zona hay espacio para letra más grande que por celda
+    double fontScale = std::min(1.5, std::max(0.4, (double)factor / 20.0));
+    int thickness = (fontScale > 0.6) ? 2 : 1;
+
+    for (int z = 0; z < num_ids; ++z) {
+        if (conteo[z] == 0) continue;
+        std::string zone_text = std::to_string(z);
+
+        int draw_x = static_cast<int>((celda[z].x + 0.5) * factor);
+        int draw_y = static_cast<int>((celda[z].y + 0.5) * factor);
+
+        cv::Size textSize = cv::getTextSize(zone_text, cv::FONT_HERSHEY_SIMPLEX, fontScale, thickness, 0);
+        cv::Point textOrg(draw_x - textSize.width / 2, draw_y + textSize.height / 2);
+
+        cv::putText(imagen, zone_text, textOrg, cv::FONT_HERSHEY_SIMPLEX, fontScale,
+                    cv::Scalar(0, 0, 0), thickness + 2, cv::LINE_AA);
+        cv::putText(imagen, zone_text, textOrg, cv::FONT_HERSHEY_SIMPLEX, fontScale,
+                    cv::Scalar(255, 255, 255), thickness, cv::LINE_AA);
+    }
+}
+
+// Dibuja el mapa de calor (y, si hay zonas, sus bordes y etiquetas) en BGR
+cv::Mat renderizar_heatmap(const Grid<float>& M, int factor, const Grid<zona_t>& Z, bool showLabels) {
+    int rows = M.filas();
+    int cols = M.columnas();
+
+    // Envolvemos el buffer contiguo de la Grid directamente (sin copiar)
+    cv::Mat matM(rows, cols, CV_32F, const_cast<float*>(M.data()));
+
     cv::Mat M_big;
     cv::resize(matM, M_big, cv::Size(), factor, factor, cv::INTER_CUBIC);
 
@@ -31,85 +101,50 @@ void plotHeatmap(const std::vector<std::vector<float>>& M, int factor, const std
     cv::normalize(M_big, Mnorm, 0, 255, cv::NORM_MINMAX, CV_8U);
     cv::applyColorMap(Mnorm, heatmap, cv::COLORMAP_VIRIDIS);
 
-    if (!matZ.empty()) {
-        cv::Mat heatmapRGBA;
-        cv::cvtColor(heatmap, heatmapRGBA, cv::COLOR_BGR2BGRA);
-        
-        cv::Mat Z_big;
-        cv::resize(matZ, Z_big, cv::Size(), factor, factor, cv::INTER_NEAREST);
-
-        for (int i = 0; i < Z_big.rows; ++i) {
-            for (int j = 0; j < Z_big.cols; ++j) {
-                int currentZone = Z_big.at<int>(i, j);
-                bool isBorder = false;
-
-                if (j + 1 < Z_big.cols) {
-                    if (currentZone != Z_big.at<int>(i, j + 1)) {
-                        isBorder = true;
-                    }
-                }
-                
-                if (i + 1 < Z_big.rows) {
-                    if (currentZone != Z_big.at<int>(i + 1, j)) {
-                        isBorder = true;
-                    }
-                }
-
-                if (isBorder) {
-                    heatmapRGBA.at<cv::Vec4b>(i, j) = cv::Vec4b(0, 0, 0, 255);
-                }
-            }
-        }
-        
-        // La flag para mostrar los id de cada zona
-        
-        if (showLabels) {
-            double fontScale = std::min(0.8, std::max(0.2, (double)factor / 40.0));
-            int thickness = (fontScale > 0.4) ? 2 : 1;
-
-            // Iteramos sobre la matriz de zonas ORIGINAL
-            for(int i = 0; i < matZ.rows; ++i) {
-                for(int j = 0; j < matZ.cols; ++j) {
-                    
-                   
-                    int zone_id = matZ.at<int>(i,j);
-                    std::string zone_text = std::to_string(zone_id);
-
-                    int draw_x = static_cast<int>((j + 0.5) * factor);
-                    int draw_y = static_cast<int>((i + 0.5) * factor);
-
-                    cv::Size textSize = cv::getTextSize(zone_text, cv::FONT_HERSHEY_SIMPLEX, fontScale, thickness, 0);
-                    cv::Point textOrg(draw_x - textSize.width / 2, draw_y + textSize.height / 2);
-
-                    cv::putText(heatmapRGBA, 
-                                zone_text, 
-                                textOrg, 
-                                cv::FONT_HERSHEY_SIMPLEX, 
-                                fontScale,
-                                cv::Scalar(0, 0, 0, 255),
-                                thickness + 1, 
-                                cv::LINE_AA);
-                    cv::putText(heatmapRGBA, 
-                                zone_text, 
-                                textOrg, 
-                                cv::FONT_HERSHEY_SIMPLEX, 
-                                fontScale,
-                                cv::Scalar(255, 255, 255, 255), 
-                                thickness,
-                                cv::LINE_AA);
-                }
-            }
-        }
-        
-        int borderExtension = 2;
-        cv::Mat expandedHeatmap;
-        cv::copyMakeBorder(heatmapRGBA, expandedHeatmap, borderExtension, borderExtension, 
-                          borderExtension, borderExtension, cv::BORDER_CONSTANT, cv::Scalar(255,255,255,255));
+    if (Z.empty()) return heatmap;
 
-        cv::cvtColor(expandedHeatmap, heatmap, cv::COLOR_BGRA2BGR);
-    }
+    cv::Mat matZ;
+    cv::Mat(rows, cols, CV_16U, const_cast<zona_t*>(Z.data())).convertTo(matZ, CV_32S);
+
+    cv::Mat Z_big;
+    cv::resize(matZ, Z_big, cv::Size(), factor, factor, cv::INTER_NEAREST);
+    heatmap.setTo(cv::Scalar(0, 0, 0), bordes_zonas(Z_big));
+
+    // La flag para mostrar los id de cada zona
+    if (showLabels) dibujar_etiquetas(heatmap, matZ, factor);
 
-    std::string windowTitle = !matZ.empty() ? "Mapa de Calor con Zonas" : "Mapa de Calor";
+    int borderExtension = 2;
+    cv::Mat expandedHeatmap;
+    cv::copyMakeBorder(heatmap, expandedHeatmap, borderExtension, borderExtension,
+                       borderExtension, borderExtension, cv::BORDER_CONSTANT, cv::Scalar(255, 255, 255));
+    return expandedHeatmap;
+}
+
+} // namespace
+
+int factorHeatmap(int filas, int columnas) {
+    int lado = std::max(1, std::max(filas, columnas));
+    return std::max(1, std::min(FACTOR_HEATMAP, LADO_MAXIMO_IMAGEN / lado));
+}
+
+void plotHeatmap(const Grid<float>& M, int factor, const Grid<zona_t>& Z, bool showLabels) {
+    cv::Mat heatmap = renderizar_heatmap(M, factor, Z, showLabels);
+
+    std::string windowTitle = !Z.empty() ? "Mapa de Calor con Zonas" : "Mapa de Calor";
     cv::imshow(windowTitle, heatmap);
     cv::waitKey(0);
-}
\ No newline at end of file
+}
+
+void saveHeatmap(const std::string& ruta, const Grid<float>& M, int factor, const Grid<zona_t>& Z, bool showLabels) {
+    cv::Mat heatmap = renderizar_heatmap(M, factor, Z, showLabels);
+
+    bool escrito = false;
+    try {
+        escrito = cv::imwrite(ruta, heatmap);
+    } catch (const cv::Exception& e) {
+        throw std::runtime_error("No se pudo escribir la imagen " + ruta + ": " + e.what());
+    }
+    if (!escrito) {
+        throw std::runtime_error("No se pudo escribir la imagen: " + ruta);
+    }
+}
@@ -0,0 +1,216 @@
+#include "inicializacion.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+
+namespace {
+
+// Tope de candidatas para el sorteo k-means++ (evita O(N*M*p) en mapas grandes)
+constexpr int MAX_CANDIDATAS_KMEANSPP = 4096;
+
+void validar_zonas(const Instancia& instancia) {
+    long long celdas = static_cast<long long>(instancia.N_filas) * instancia.M_columnas;
+    if (instancia.num_zonas > celdas) {
+        throw std::runtime_error("num_zonas (" + std::to_string(instancia.num_zonas) +
+                                 ") no puede superar el número de celdas (" + std::to_string(celdas) + ")");
+    }
+}
+
+} // namespace
+
+std::vector<Punto> elegir_semillas_uniformes(const Instancia& instancia, std::mt19937& gen) {
+    validar_zonas(instancia);
+
+    // Índices lineales ya elegidos: memoria O(p), no O(N*M)
+    std::unordered_set<long long> ocupadas;
+    ocupadas.reserve(instancia.num_zonas);
+    std::vector<Punto> semillas;
+    semillas.reserve(instancia.num_zonas);
+    while (static_cast<int>(semillas.size()) < instancia.num_zonas) {
+        Punto p = {randint(gen, 0, instancia.N_filas - 1), randint(gen, 0, instancia.M_columnas - 1)};
+        long long indice = static_cast<long long>(p.r) * instancia.M_columnas + p.c;
+        if (ocupadas.insert(indice).second) semillas.push_back(p);
+    }
+    return semillas;
+}
+
+std::vector<Punto> elegir_semillas_kmeanspp(const Instancia& instancia, std::mt19937& gen) {
+    validar_zonas(instancia);
+
+    const int N = instancia.N_filas;
+    const int M = instancia.M_columnas;
+    const int total = N * M;
+    const int p = instancia.num_zonas;
+
+    // Candidatas: todas las celdas, o una muestra si el mapa es grande
+    std::vector<int> candidatas;
+    if (total <= std::max(MAX_CANDIDATAS_KMEANSPP, p)) {
+        candidatas.resize(total);
+        for (int k = 0; k < total; ++k) candidatas[k] = k;
+    } else {
+        int tam = std::max(MAX_CANDIDATAS_KMEANSPP, 4 * p);
+        candidatas.resize(std::min(tam, total));
+        for (int& c : candidatas) c = randint(gen, 0, total - 1);
+    }
+
+    std::vector<char> elegida(total, 0);
+    std::vector<double> d2(candidatas.size(), std::numeric_limits<double>::infinity());
+    std::vector<Punto> semillas;
+    semillas.reserve(p);
+    std::uniform_real_distribution<double> uniforme(0.0, 1.0);
+
+    auto agregar = [&](int celda) {
+        elegida[celda] = 1;
+        semillas.push_back({celda / M, celda % M});
+        double v = instancia.datos_terreno[celda];
+        for (std::size_t k = 0; k < candidatas.size(); ++k) {
+            double d = instancia.datos_terreno[candidatas[k]] - v;
+            d2[k] = elegida[candidatas[k]] ? 0.0 : std::min(d2[k], d * d);
+        }
+    };
+
+    agregar(candidatas[randint(gen, 0, static_cast<int>(candidatas.size()) - 1)]);
+    while (static_cast<int>(semillas.size()) < p) {
+        double suma = 0.0;
+        for (double d : d2) suma += d;
+
+        int celda = -1;
+        if (suma > 0.0) {
+            double objetivo = uniforme(gen) * suma;
+            for (std::size_t k = 0; k < candidatas.size(); ++k) {
+                objetivo -= d2[k];
+                if (objetivo < 0.0 && d2[k] > 0.0) {
+                    celda = candidatas[k];
+                    break;
+                }
+            }
+        }
+        if (celda < 0) {
+            // Terreno sin variación entre candidatas (o redondeo): cualquier celda libre
+            do {
+                celda = randint(gen, 0, total - 1);
+            } while (elegida[celda]);
+        }
+        agregar(celda);
+    }
+    return semillas;
+}
+
+Solucion generar_solucion_inicial_voronoi(const Instancia& instancia, std::mt19937& gen) {
+    std::vector<Punto> semillas = elegir_semillas_uniformes(instancia, gen);
+
+    const int N = instancia.N_filas;
+    const int M = instancia.M_columnas;
+    Solucion sol(N, M);
+
+    // BFS por capas desde todas las semillas a la vez: la cola es un vector
+    // recorrido en orden, cada celda entra una sola vez
+    std::vector<char> visitada(sol.zonas_asignadas.size(), 0);
+    std::vector<int> cola;
+    cola.reserve(sol.zonas_asignadas.size());
+    for (int k = 0; k < static_cast<int>(semillas.size()); ++k) {
+        int indice = semillas[k].r * M + semillas[k].c;
+        visitada[indice] = 1;
+        sol.zonas_asignadas[indice] = static_cast<zona_t>(k);
+        cola.push_back(indice);
+    }
+
+    for (std::size_t frente = 0; frente < cola.size(); ++frente) {
+        int indice = cola[frente];
+        int i = indice / M;
+        int j = indice % M;
+        zona_t zona = sol.zonas_asignadas[indice];
+
+        auto visitar = [&](int vecino) {
+            if (!visitada[vecino]) {
+                visitada[vecino] = 1;
+                sol.zonas_asignadas[vecino] = zona;
+                cola.push_back(vecino);
+            }
+        };
+        if (i > 0) visitar(indice - M);
+        if (i + 1 < N) visitar(indice + M);
+        if (j > 0) visitar(indice - 1);
+        if (j + 1 < M) visitar(indice + 1);
+    }
+    return sol;
+}
+
+Solucion generar_solucion_inicial_crecimiento(const Instancia& instancia, std::mt19937& gen) {
+    std::vector<Punto> semillas = elegir_semillas_kmeanspp(instancia, gen);
+
+    const int N = instancia.N_filas;
+    const int M = instancia.M_columnas;
+    const int p = instancia.num_zonas;
+    Solucion sol(N, M);
+
+    std::vector<char> asignada(sol.zonas_asignadas.size(), 0);
+    std::vector<double> suma(p, 0.0);
+    std::vector<long long> conteo(p, 0);
+
+    // (diferencia con la media de la zona, celda, zona); el menor sale primero
+    using Candidato = std::tuple<double, int, int>;
+    std::priority_queue<Candidato, std::vector<Candidato>, std::greater<Candidato>> borde;
+
+    auto empujar_vecinos = [&](int indice, int zona) {
+        int i = indice / M;
+        int j = indice % M;
+        double media = suma[zona] / conteo[zona];
+        auto empujar = [&](int vecino) {
+            if (!asignada[vecino]) {
+                borde.emplace(std::fabs(instancia.datos_terreno[vecino] - media), vecino, zona);
+            }
+        };
+        if (i > 0) empujar(indice - M);
+        if (i + 1 < N) empujar(indice + M);
+        if (j > 0) empujar(indice - 1);
+        if (j + 1 < M) empujar(indice + 1);
+    };
+
+    auto asignar = [&](int indice, int zona) {
+        asignada[indice] = 1;
+        sol.zonas_asignadas[indice] = static_cast<zona_t>(zona);
+        suma[zona] += instancia.datos_terreno[indice];
+        ++conteo[zona];
+    };
+
+    for (int k = 0; k < p; ++k) asignar(semillas[k].r * M + semillas[k].c, k);
+    for (int k = 0; k < p; ++k) empujar_vecinos(semillas[k].r * M + semillas[k].c, k);
+
+    while (!borde.empty()) {
+        auto [diferencia, indice, zona] = borde.top();
+        borde.pop();
+        (void)diferencia;
+        if (asignada[indice]) continue; // Ya la tomó otra zona (entrada vieja)
+        asignar(indice, zona);
+        empujar_vecinos(indice, zona);
+    }
+    return sol;
+}
+
+Solucion generar_solucion_inicial(const Instancia& instancia, std::mt19937& gen, MetodoInicial metodo) {
+    switch (metodo) {
+        case MetodoInicial::VORONOI:
+            return generar_solucion_inicial_voronoi(instancia, gen);
+        case MetodoInicial::CRECIMIENTO:
+            return generar_solucion_inicial_crecimiento(instancia, gen);
+        case MetodoInicial::GREEDY:
+        default:
+            return generar_solucion_inicial_aleatoria(instancia, gen);
+    }
+}
+
+const char* nombre_metodo_inicial(MetodoInicial metodo) {
+    switch (metodo) {
+        case MetodoInicial::VORONOI: return "voronoi";
+        case MetodoInicial::CRECIMIENTO: return "crecimiento";
+        case MetodoInicial::GREEDY:
+        default: return "greedy";
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <random>
+#include <vector>
+#include "spp.hpp"
+
+/**
+ * @brief Elige `num_zonas` celdas distintas al azar como semillas.
+ *
+ * Consume el generador igual que el greedy original (pares (fila, columna)
+ * uniformes, descartando repetidas), pero detecta repetidas con un conjunto
+ * hash de índices en vez de comparar contra todas las semillas: O(p)
+ * esperado en tiempo y memoria, sin depender del tamaño del mapa.
+ */
+std::vector<Punto> elegir_semillas_uniformes(const Instancia& instancia, std::mt19937& gen);
+
+/**
+ * @brief Elige semillas estilo k-means++ sobre los valores del terreno.
+ *
+ * La primera es uniforme; cada siguiente se sortea con probabilidad
+ * proporcional a D(x)^2, donde D(x) es la distancia en valor a la semilla
+ * más parecida. Así las semillas cubren los distintos niveles del terreno.
+ * En mapas grandes se sortea sobre una muestra aleatoria de celdas.
+ */
+std::vector<Punto> elegir_semillas_kmeanspp(const Instancia& instancia, std::mt19937& gen);
+
+/**
+ * @brief Voronoi por BFS multi-fuente desde semillas uniformes, en O(N*M).
+ *
+ * Cada celda va a la semilla más cercana en distancia Manhattan (4-vecinos),
+ * por lo que cada zona queda conexa y sin islas.
+ */
+Solucion generar_solucion_inicial_voronoi(const Instancia& instancia, std::mt19937& gen);
+
+/**
+ * @brief Crecimiento de regiones guiado por valor desde semillas k-means++.
+ *
+ * Las zonas crecen a la vez desde sus semillas; en cada paso se agrega la
+ * celda de borde cuyo valor está más cerca de la media actual de la zona
+ * vecina (cola de prioridad, O(N*M log(N*M))). Las zonas salen conexas y
+ * homogéneas, más cerca de un óptimo local que el Voronoi puramente espacial.
+ */
+Solucion generar_solucion_inicial_crecimiento(const Instancia& instancia, std::mt19937& gen);
+
+/**
+ * @brief Despacha al método de solución inicial pedido.
+ */
+Solucion generar_solucion_inicial(const Instancia& instancia, std::mt19937& gen, MetodoInicial metodo);
+
+/**
+ * @brief Nombre del método tal como se pasa a `--init`.
+ */
+const char* nombre_metodo_inicial(MetodoInicial metodo);
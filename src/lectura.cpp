@@ -0,0 +1,296 @@
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "spp.hpp"
+
+namespace {
+
+/**
+ * @struct CabeceraSppb
+ * @brief Cabecera de un archivo .sppb; le siguen filas * columnas float32 por filas.
+ */
+struct CabeceraSppb {
+    char magia[4];          // "SPPB"
+    std::uint32_t version;  // 1
+    std::uint32_t filas;
+    std::uint32_t columnas;
+};
+static_assert(sizeof(CabeceraSppb) == 16, "La cabecera .sppb debe ocupar 16 bytes");
+
+constexpr std::uint32_t VERSION_SPPB = 1;
+
+/**
+ * @class ArchivoMapeado
+ * @brief Archivo completo mapeado en memoria (solo lectura, MAP_PRIVATE).
+ */
+class ArchivoMapeado {
+public:
+    explicit ArchivoMapeado(const std::string& ruta) : base(nullptr), tamano(0) {
+        int fd = ::open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("No se pudo abrir el archivo: " + ruta);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("No se pudo leer el tamaño de: " + ruta);
+        }
+        tamano = static_cast<std::size_t>(info.st_size);
+
+        if (tamano > 0) {
+            void* p = ::mmap(nullptr, tamano, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("No se pudo mapear el archivo: " + ruta);
+            }
+            base = static_cast<char*>(p);
+            ::madvise(base, tamano, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    ~ArchivoMapeado() {
+        if (base) ::munmap(base, tamano);
+    }
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    char* datos() const { return base; }
+    std::size_t size() const { return tamano; }
+
+private:
+    char* base;
+    std::size_t tamano;
+};
+
+inline bool es_espacio(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Parser de texto sobre un buffer: salta blancos y lee con std::from_chars.
+ */
+class LectorNumeros {
+public:
+    LectorNumeros(const char* inicio, const char* fin, const std::string& ruta)
+        : inicio(inicio), actual(inicio), fin(fin), ruta(ruta) {}
+
+    template <typename T>
+    T siguiente() {
+        while (actual < fin && es_espacio(*actual)) ++actual;
+        if (actual == fin) {
+            throw std::runtime_error("Archivo truncado: " + ruta);
+        }
+        // from_chars no acepta '+' inicial, pero ifstream sí
+        if (*actual == '+') ++actual;
+
+        T valor{};
+        auto resultado = std::from_chars(actual, fin, valor);
+        if (resultado.ec != std::errc()) {
+            throw std::runtime_error("Valor inválido en " + ruta + " (byte " +
+                                     std::to_string(actual - inicio) + ")");
+        }
+        actual = resultado.ptr;
+        return valor;
+    }
+
+private:
+    const char* inicio;
+    const char* actual;
+    const char* fin;
+    const std::string& ruta;
+};
+
+bool termina_en(const std::string& s, const std::string& sufijo) {
+    return s.size() >= sufijo.size() && s.compare(s.size() - sufijo.size(), sufijo.size(), sufijo) == 0;
+}
+
+/**
+ * @brief ¿Existe una caché .sppb más nueva que el .spp de origen?
+ */
+bool cache_vigente(const std::string& ruta_spp, const std::string& ruta_sppb) {
+    std::error_code ec;
+    auto t_cache = std::filesystem::last_write_time(ruta_sppb, ec);
+    if (ec) return false;
+    auto t_origen = std::filesystem::last_write_time(ruta_spp, ec);
+    if (ec) return false;
+    return t_cache >= t_origen;
+}
+
+} // namespace
+
+/**
+ * @brief Lee un .spp de texto mapeándolo en memoria y parseando con std::from_chars
+ * directamente a un buffer contiguo (sin streams ni reservas por fila).
+ */
+Grid<float> leer_spp_texto(const std::string& filename) {
+    ArchivoMapeado archivo(filename);
+    LectorNumeros lector(archivo.datos(), archivo.datos() + archivo.size(), filename);
+
+    int m = lector.siguiente<int>();
+    int n = lector.siguiente<int>();
+    if (m <= 0 || n <= 0) {
+        throw std::runtime_error("Dimensiones inválidas en " + filename);
+    }
+
+    Grid<float> datos(m, n);
+    float* salida = datos.data();
+    for (std::size_t k = 0; k < datos.size(); ++k) {
+        salida[k] = lector.siguiente<float>();
+    }
+    return datos;
+}
+
+/**
+ * @brief Lector original con std::ifstream, se mantiene como referencia para
+ * comparar tiempos y resultados.
+ */
+Grid<float> leer_spp_ifstream(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("No se pudo abrir el archivo: " + filename);
+    }
+
+    int m, n;
+    file >> m >> n;
+    Grid<float> datos(m, n);
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            file >> datos(i, j);
+        }
+    }
+    return datos;
+}
+
+/**
+ * @brief Mapea un .sppb sin copiar: la Grid devuelta apunta a las páginas
+ * del archivo (MAP_PRIVATE, así que escribir en ella no toca el disco).
+ */
+Grid<float> leer_sppb(const std::string& filename) {
+    auto archivo = std::make_shared<ArchivoMapeado>(filename);
+
+    CabeceraSppb cabecera;
+    if (archivo->size() < sizeof(cabecera)) {
+        throw std::runtime_error("Archivo .sppb truncado: " + filename);
+    }
+    std::memcpy(&cabecera, archivo->datos(), sizeof(cabecera));
+
+    if (std::memcmp(cabecera.magia, "SPPB", 4) != 0 || cabecera.version != VERSION_SPPB) {
+        throw std::runtime_error("Cabecera .sppb inválida: " + filename);
+    }
+    // Grid indexa con int: una dimensión nula o mayor a INT_MAX no cabe
+    const auto maximo = static_cast<std::uint32_t>(std::numeric_limits<int>::max());
+    if (cabecera.filas == 0 || cabecera.columnas == 0 || cabecera.filas > maximo || cabecera.columnas > maximo) {
+        throw std::runtime_error("Dimensiones de .sppb inválidas: " + filename);
+    }
+    std::size_t celdas = static_cast<std::size_t>(cabecera.filas) * cabecera.columnas;
+    if (archivo->size() != sizeof(cabecera) + celdas * sizeof(float)) {
+        throw std::runtime_error("Tamaño de .sppb inconsistente: " + filename);
+    }
+
+    float* valores = reinterpret_cast<float*>(archivo->datos() + sizeof(cabecera));
+    return Grid<float>::vista(static_cast<int>(cabecera.filas), static_cast<int>(cabecera.columnas),
+                              valores, archivo);
+}
+
+/**
+ * @brief Escribe `datos` como .spp de texto, con dos decimales.
+ */
+void escribir_spp(const std::string& ruta, const Grid<float>& datos) {
+    std::ofstream out(ruta);
+    if (!out.is_open()) {
+        throw std::runtime_error("No se pudo escribir el archivo: " + ruta);
+    }
+    out << datos.filas() << " " << datos.columnas() << "\n" << std::fixed << std::setprecision(2);
+    for (int i = 0; i < datos.filas(); ++i) {
+        for (int j = 0; j < datos.columnas(); ++j) {
+            out << datos(i, j) << (j + 1 < datos.columnas() ? " " : "\n");
+        }
+    }
+}
+
+/**
+ * @brief Escribe `datos` en formato .sppb. Escribe a un temporal y lo renombra,
+ * para que un lector concurrente nunca vea un archivo a medias.
+ */
+void escribir_sppb(const std::string& filename, const Grid<float>& datos) {
+    std::string temporal = filename + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(temporal, std::ios::binary);
+        if (!out.is_open()) {
+            throw std::runtime_error("No se pudo escribir el archivo: " + filename);
+        }
+        CabeceraSppb cabecera;
+        std::memcpy(cabecera.magia, "SPPB", 4);
+        cabecera.version = VERSION_SPPB;
+        cabecera.filas = static_cast<std::uint32_t>(datos.filas());
+        cabecera.columnas = static_cast<std::uint32_t>(datos.columnas());
+        out.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+        out.write(reinterpret_cast<const char*>(datos.data()), datos.size() * sizeof(float));
+        if (!out) {
+            out.close();
+            std::remove(temporal.c_str());
+            throw std::runtime_error("Error escribiendo: " + filename);
+        }
+    }
+    if (std::rename(temporal.c_str(), filename.c_str()) != 0) {
+        std::remove(temporal.c_str());
+        throw std::runtime_error("No se pudo renombrar " + temporal + " a " + filename);
+    }
+}
+
+/**
+ * @brief Lee los datos del terreno desde un archivo .spp (texto) o .sppb (binario).
+ *
+ * El archivo .spp debe tener el siguiente formato:
+ *
+ * * - La primera línea contiene dos enteros: m n (número de filas y columnas)
+ *
+ * * - Las siguientes m líneas contienen n valores flotantes cada una,
+ *   separados por espacios, representando los datos del terreno.
+ *
+ * Con `usar_cache`, al leer `x.spp` se busca `x.sppb` al lado: si existe y es
+ * más nueva se mapea sin copiar; si no, se parsea el texto y se escribe la
+ * caché para la próxima vez (si el directorio no es escribible se sigue sin ella).
+ */
+Grid<float> leer_datos(const std::string& filename, bool usar_cache) {
+    if (termina_en(filename, ".sppb")) {
+        return leer_sppb(filename);
+    }
+    if (!usar_cache) {
+        return leer_spp_texto(filename);
+    }
+
+    std::string ruta_cache = filename + "b";
+    if (cache_vigente(filename, ruta_cache)) {
+        try {
+            return leer_sppb(ruta_cache);
+        } catch (const std::runtime_error&) {
+            // Caché corrupta o de otra versión: se regenera
+        }
+    }
+
+    Grid<float> datos = leer_spp_texto(filename);
+    try {
+        escribir_sppb(ruta_cache, datos);
+    } catch (const std::runtime_error&) {
+        // Sin permisos de escritura: seguimos sin caché
+    }
+    return datos;
+}
@@ -1,414 +1,280 @@
 #include <iostream>
-#include <vector>
-#include <cmath>      // Para sqrt y pow
-#include <numeric>    // Para std::accumulate
-#include <random>     // Para generación de números aleatorios (proceso estocástico)
 #include <limits>     // Para std::numeric_limits
-#include <map>        // Para agrupar valores por zona
-#include <fstream>    // Para lectura de archivos
+#include <stdexcept>
+#include <sstream>
 #include <string>
 #include <chrono>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
 
-// Muestra el mapa de calor
-void plotHeatmap(const std::vector<std::vector<float>>& M, int factor, const std::vector<std::vector<int>>& Z = {}, bool showLabels = false);
-
-// --------------------------------------------------------------------------
-// ESTRUCTURAS DE DATOS PRINCIPALES
-// --------------------------------------------------------------------------
-
-/**
- * @struct Instancia cualquiera, para el comienzo del algoritmo se puede definir la instancia inicial y luego esta se va modificando mediante avance el algoritmo.
- * @brief Almacena los datos de entrada del problema.
- *
- * @var datos_terreno Matriz (N x M) con los valores del índice (ej. NDVI, humedad).
- * @var num_zonas (p) El número de sensores/zonas a definir.
- */
-struct Instancia {
-    std::vector<std::vector<float>> datos_terreno; 
-    int num_zonas;
-    int N_filas;
-    int M_columnas;
+#include "spp.hpp"
+#include "archivo_solucion.hpp"
+#include "batch.hpp"
+#include "estadisticas.hpp"
+#include "inicializacion.hpp"
+#include "motores.hpp"
+#include "varianza.hpp"
 
-    Instancia(const std::vector<std::vector<float>>& datos, int p)
-        : datos_terreno(datos), num_zonas(p) {
-        N_filas = datos.size();
-        M_columnas = (N_filas > 0) ? datos[0].size() : 0;
-    }
-};
+int main(int argc, char* argv[]) {
 
-/**
- * @struct Solucion
- * @brief Representa una solución al problema.
- *
- * @var zonas_asignadas Matriz (N x M) donde cada celda (i, j) tiene un ID
- * de zona (0 a p-1).
- * @var costo El valor de la función objetivo (costo) para esta solución.
- * Usamos 'double' para precisión.
- */
-struct Solucion {
-    std::vector<std::vector<int>> zonas_asignadas;
-    double costo;
+    // Modo batch: spp_solver --batch jobs.txt [options]
+    bool modo_batch = (argc >= 3 && std::string(argv[1]) == "--batch");
 
-    Solucion(int N, int M) : costo(std::numeric_limits<double>::infinity()) {
-        zonas_asignadas.resize(N, std::vector<int>(M, 0));
+    if (argc < 4 && !modo_batch) {
+        std::cerr << "Uso: " << argv[0] << " <archivo_datos.spp> <num_zonas> <alpha> [options]" << std::endl;
+        std::cerr << "     " << argv[0] << " --batch <jobs.txt> [options]" << std::endl;
+        std::cerr << "Opciones: --no-gui, --threads N, --seed S, --estrategia first|best|teselas, --tesela L, --engine hc|sa|tabu, --init greedy|voronoi|crecimiento, --conexo, --multinivel, --niveles L, --verificar-delta, --validar-varianza," << std::endl;
+        std::cerr << "          --banda otra.spp, --pesos w0,w1,..." << std::endl;
+        std::cerr << "          --poblacion, --subpoblaciones S, --pob-tamano N, --pob-generaciones G, --pob-migracion K," << std::endl;
+        std::cerr << "          --sin-cache, --restarts N, --time-limit SEG, --max-evals N, --trace traza.csv, --stats out.json, --save out.png, --save-solution out.sppz, --init-from in.sppz," << std::endl;
+        std::cerr << "          --sa-t0 T, --sa-enfriamiento F, --sa-pasos N, --sa-tfinal R, --tabu-tenencia T, --tabu-candidatos K, --tabu-iter N" << std::endl;
+        return 1;
     }
-};
 
-struct Punto {
-    int r,c;
-};
-
-// --------------------------------------------------------------------------
-// MOTOR DE NÚMEROS ALEATORIOS (Para 'Restart')
-// --------------------------------------------------------------------------
-std::mt19937 gen(std::random_device{}()); // Generador Mersenne Twister
-
-/**
- * @brief Genera un entero aleatorio en el rango [min, max]
- */
-int randint(int min, int max) {
-    std::uniform_int_distribution<> dis(min, max);
-    return dis(gen);
-}
-
-
-// 1. Generación de Solución Inicial (Greedy Espacial o Aleatoria)
-
-/**
- * @brief Genera una solución inicial aleatoria.
- *
- * Asigna cada celda (i, j) del terreno a una zona aleatoria (0 a p-1).
- * Esto sirve como punto de partida para el Hill Climbing y es esencial
- * para la estrategia de "Restart", ya que cada "Restart" comienza
- * desde un punto aleatorio diferente.
- *
- * @param instancia Los datos del problema.
- * @return Una 'Solucion' inicializada aleatoriamente.
- */
-Solucion generar_solucion_inicial_aleatoria(const Instancia& instancia) {
-    Solucion sol(instancia.N_filas, instancia.M_columnas);
-
-    std::vector<Punto> semillas;
-    while (semillas.size() < instancia.num_zonas) {
-        Punto p = {randint(0, instancia.N_filas -1), randint(0, instancia.M_columnas -1)};
-        bool existe = false;
-        for (const auto& s : semillas) {
-            if (s.r == p.r && s.c == p.c) {
-                existe = true;
-                break;
+    bool no_gui = false;
+    bool mostrar_etiquetas = false;
+    std::string archivo_imagen;
+    bool validar_varianza = false;
+    std::string archivo_solucion;
+    std::string archivo_inicial;
+    std::vector<std::string> archivos_banda;
+    std::vector<double> pesos_banda;
+    bool semilla_fijada = false;
+    bool restarts_fijados = false;
+    OpcionesBusqueda opciones;
+
+    int primera_opcion = modo_batch ? 3 : 4;
+    for (int i = primera_opcion; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hay_valor = (i + 1 < argc);
+        if (arg == "--no-gui") {
+            no_gui = true;
+        } else if (arg == "--conexo") {
+            opciones.conexo = true;
+        } else if (arg == "--multinivel") {
+            opciones.multinivel = true;
+        } else if (arg == "--niveles" && hay_valor) {
+            opciones.niveles = std::stoi(argv[++i]);
+            opciones.multinivel = true;
+        } else if (arg == "--banda" && hay_valor) {
+            archivos_banda.push_back(argv[++i]);
+        } else if (arg == "--pesos" && hay_valor) {
+            std::stringstream lista(argv[++i]);
+            std::string peso;
+            while (std::getline(lista, peso, ',')) pesos_banda.push_back(std::stod(peso));
+        } else if (arg == "--poblacion") {
+            opciones.poblacion = true;
+        } else if (arg == "--subpoblaciones" && hay_valor) {
+            opciones.parametros_poblacion.subpoblaciones = std::stoi(argv[++i]);
+            opciones.poblacion = true;
+        } else if (arg == "--pob-tamano" && hay_valor) {
+            opciones.parametros_poblacion.tamano = std::stoi(argv[++i]);
+            opciones.poblacion = true;
+        } else if (arg == "--pob-generaciones" && hay_valor) {
+            opciones.parametros_poblacion.generaciones = std::stoi(argv[++i]);
+            opciones.poblacion = true;
+        } else if (arg == "--pob-migracion" && hay_valor) {
+            opciones.parametros_poblacion.intervalo_migracion = std::stoi(argv[++i]);
+            opciones.poblacion = true;
+        } else if (arg == "--tesela" && hay_valor) {
+            opciones.lado_tesela = std::stoi(argv[++i]);
+            opciones.estrategia = EstrategiaBusqueda::TESELAS;
+        } else if (arg == "--validar-varianza") {
+            validar_varianza = true;
+        } else if (arg == "--verificar-delta") {
+            opciones.verificar_delta = true;
+        } else if (arg == "--sin-cache") {
+            opciones.usar_cache = false;
+        } else if (arg == "--threads" && hay_valor) {
+            opciones.num_hilos = std::stoi(argv[++i]);
+            if (opciones.num_hilos <= 0) {
+                opciones.num_hilos = std::max(1u, std::thread::hardware_concurrency());
             }
-        }
-        if (!existe) {
-            semillas.push_back(p);
-        }
-    }
-
-    // Ahora la asignacion greedy espacial
-
-    for (int i = 0; i < instancia.N_filas; ++i) {
-        for (int j = 0; j < instancia.M_columnas; ++j) {
-            int zona_mas_cercana = 0;
-            double distancia_minima = std::numeric_limits<double>::infinity();
-            for (int k = 0; k < instancia.num_zonas; ++k) {
-                double distancia = std::sqrt(std::pow(i - semillas[k].r, 2) + std::pow(j - semillas[k].c, 2));
-                if (distancia < distancia_minima) {
-                    distancia_minima = distancia;
-                    zona_mas_cercana = k;
-                }
+        } else if (arg == "--restarts" && hay_valor) {
+            opciones.num_restarts = std::stoi(argv[++i]);
+            restarts_fijados = true;
+        } else if (arg == "--time-limit" && hay_valor) {
+            opciones.limite_tiempo = std::stod(argv[++i]);
+        } else if (arg == "--max-evals" && hay_valor) {
+            opciones.max_evaluaciones = std::stoll(argv[++i]);
+        } else if (arg == "--trace" && hay_valor) {
+            opciones.archivo_traza = argv[++i];
+        } else if (arg == "--save" && hay_valor) {
+            archivo_imagen = argv[++i];
+        } else if (arg == "--save-solution" && hay_valor) {
+            archivo_solucion = argv[++i];
+        } else if (arg == "--init-from" && hay_valor) {
+            archivo_inicial = argv[++i];
+        } else if (arg == "--stats" && hay_valor) {
+            opciones.archivo_estadisticas = argv[++i];
+        } else if (arg == "--seed" && hay_valor) {
+            opciones.semilla = std::stoull(argv[++i]);
+            semilla_fijada = true;
+        } else if (arg == "--init" && hay_valor) {
+            std::string metodo = argv[++i];
+            if (metodo == "greedy") {
+                opciones.inicial = MetodoInicial::GREEDY;
+            } else if (metodo == "voronoi") {
+                opciones.inicial = MetodoInicial::VORONOI;
+            } else if (metodo == "crecimiento") {
+                opciones.inicial = MetodoInicial::CRECIMIENTO;
+            } else {
+                std::cerr << "Metodo inicial desconocido: " << metodo << " (usar greedy, voronoi o crecimiento)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--engine" && hay_valor) {
+            std::string motor = argv[++i];
+            if (motor == "hc") {
+                opciones.motor = MotorBusqueda::HC;
+            } else if (motor == "sa") {
+                opciones.motor = MotorBusqueda::SA;
+            } else if (motor == "tabu") {
+                opciones.motor = MotorBusqueda::TABU;
+            } else {
+                std::cerr << "Motor desconocido: " << motor << " (usar hc, sa o tabu)" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--sa-t0" && hay_valor) {
+            opciones.recocido.temperatura_inicial = std::stod(argv[++i]);
+        } else if (arg == "--sa-enfriamiento" && hay_valor) {
+            opciones.recocido.enfriamiento = std::stod(argv[++i]);
+        } else if (arg == "--sa-pasos" && hay_valor) {
+            opciones.recocido.pasos_por_temperatura = std::stoi(argv[++i]);
+        } else if (arg == "--sa-tfinal" && hay_valor) {
+            opciones.recocido.temperatura_final_relativa = std::stod(argv[++i]);
+        } else if (arg == "--tabu-tenencia" && hay_valor) {
+            opciones.tabu.tenencia = std::stoi(argv[++i]);
+        } else if (arg == "--tabu-candidatos" && hay_valor) {
+            opciones.tabu.candidatos = std::stoi(argv[++i]);
+        } else if (arg == "--tabu-iter" && hay_valor) {
+            opciones.tabu.max_sin_mejora = std::stoi(argv[++i]);
+        } else if (arg == "--estrategia" && hay_valor) {
+            std::string estrategia = argv[++i];
+            if (estrategia == "first") {
+                opciones.estrategia = EstrategiaBusqueda::FIRST_IMPROVEMENT;
+            } else if (estrategia == "best") {
+                opciones.estrategia = EstrategiaBusqueda::BEST_IMPROVEMENT;
+            } else if (estrategia == "teselas") {
+                opciones.estrategia = EstrategiaBusqueda::TESELAS;
+            } else {
+                std::cerr << "Estrategia desconocida: " << estrategia << " (usar first, best o teselas)" << std::endl;
+                return 1;
             }
-            sol.zonas_asignadas[i][j] = zona_mas_cercana;
+        } else if (i == 4 && !modo_batch && (arg == "1" || arg == "true")) {
+            // 4to argumento: mostrar etiquetas de zona en el heatmap
+            mostrar_etiquetas = true;
+        } else {
+            std::cerr << "Opcion desconocida o incompleta: " << arg << std::endl;
+            return 1;
         }
     }
-    // El costo se calculará por separado
-    return sol;
-}
 
-// 2. Cálculo de Función de Evaluación
-
-/**
- * @brief Función auxiliar para calcular la varianza de un conjunto de datos.
- *
- * Varianza = (1/N) * Sum( (x_i - media)^2 )
- *
- * @param valores Vector de valores de una zona.
- * @return La varianza (double) de los valores.
- */
-double calcular_varianza(const std::vector<float>& valores) {
-    if (valores.empty() || valores.size() == 1) {
-        return 0.0; // Varianza de 0 o 1 elemento es 0.
+    bool hay_presupuesto = (opciones.limite_tiempo > 0.0 || opciones.max_evaluaciones > 0);
+    if (restarts_fijados && opciones.num_restarts < 1) {
+        std::cerr << "--restarts debe ser al menos 1" << std::endl;
+        return 1;
     }
-
-    double n = valores.size();
-    
-    // Calcular la media
-    double suma = std::accumulate(valores.begin(), valores.end(), 0.0);
-    double media = suma / n;
-
-    // Calcular la suma de los cuadrados de las diferencias
-    double suma_cuadrados_dif = 0.0;
-    for (float val : valores) {
-        suma_cuadrados_dif += std::pow(val - media, 2);
+    if (opciones.recocido.enfriamiento <= 0.0 || opciones.recocido.enfriamiento >= 1.0 ||
+        opciones.recocido.temperatura_final_relativa <= 0.0 || opciones.recocido.temperatura_final_relativa >= 1.0) {
+        std::cerr << "--sa-enfriamiento y --sa-tfinal deben estar entre 0 y 1" << std::endl;
+        return 1;
     }
-
-    double varianza = suma_cuadrados_dif / n;
-    return varianza;
-}
-
-/**
- * @brief Calcula la varianza total de todos los datos en la instancia.
- */
-double calcular_varianza_total(const Instancia& instancia){
-    std::vector<float> full_data;
-    for (int i = 0; i < instancia.N_filas; ++i) {
-        for (int j = 0; j < instancia.M_columnas; ++j) {
-            full_data.push_back(instancia.datos_terreno[i][j]);
-        }
+    if (opciones.lado_tesela < 4) {
+        std::cerr << "--tesela debe ser al menos 4" << std::endl;
+        return 1;
     }
-    return calcular_varianza(full_data);
-}
-
-/**
- * @brief Calcula la función de evaluación (costo) de una solución.
- *
- * Según lo investigado en el estado del arte, el objetivo del problema es
- * minimizar la pérdida de representatividad de las zonas definidas.
- * Lo que efectivamente se traduce a minimizar la suma de las varianzas internas
- * de cada zona.
- *
- * @param instancia Los datos del terreno (S).
- * @param solucion La partición de zonas (Z).
- * @return El costo total (Suma de Varianzas Internas) como un 'double'.
- */
-double evaluar_solucion(const Instancia& instancia, const Solucion& solucion, double umbral_varianza) {
-    // Usamos un map para agrupar todos los valores que pertenecen a cada zona
-    std::map<int, std::vector<float>> valores_por_zona;
-
-    // Calculo de varianza por zona
-    for (int i = 0; i < instancia.N_filas; ++i) {
-        for (int j = 0; j < instancia.M_columnas; ++j) {
-
-            int zona_id = solucion.zonas_asignadas[i][j];
-            float valor_dato = instancia.datos_terreno[i][j];
-            valores_por_zona[zona_id].push_back(valor_dato);
-        }
+    if (opciones.tabu.tenencia < 0 || opciones.tabu.candidatos < 1) {
+        std::cerr << "--tabu-tenencia debe ser >= 0 y --tabu-candidatos >= 1" << std::endl;
+        return 1;
     }
-
-    double costo_total = 0.0;
-    double penalizacion_homogeneidad = 0.0;
-    const double deterrant = 1e9; // Factor de penalización muuuuy grande
-
-    for (int k = 0; k < instancia.num_zonas; ++k) {
-        // Busca la zona k en el map. Si no existe (zona vacía), el vector estará vacío.
-        double varianza_zona = calcular_varianza(valores_por_zona[k]);
-        costo_total += varianza_zona;
-        if (varianza_zona > umbral_varianza) {
-            // Si no cumple el umbral, aplicamos una penalización grande
-            penalizacion_homogeneidad += (varianza_zona - umbral_varianza) * deterrant;
-        }
+    const ParametrosPoblacion& poblacion = opciones.parametros_poblacion;
+    if (poblacion.subpoblaciones < 0 || poblacion.tamano < 2 || poblacion.generaciones < 0 ||
+        poblacion.intervalo_migracion < 1) {
+        std::cerr << "--pob-tamano debe ser al menos 2, --pob-migracion al menos 1 y --subpoblaciones y --pob-generaciones >= 0" << std::endl;
+        return 1;
     }
-
-    // Detección de islas y su respectiva penalización
-
-    double penalizacion_islas = 0.0;
-    // El castigo por ser isla debe ser lo suficientemente alto para motivar el cambio,
-    // pero idealmente menor que violar la homogeneidad global.
-    const double M_ISLA = 5000.0; 
-
-    // Direcciones para vecinos: Arriba, Abajo, Izquierda, Derecha
-    int dr[] = {-1, 1, 0, 0};
-    int dc[] = {0, 0, -1, 1};
-
-    for (int i = 0; i < instancia.N_filas; ++i) {
-        for (int j = 0; j < instancia.M_columnas; ++j) {
-            
-            int mi_zona = solucion.zonas_asignadas[i][j];
-            bool tengo_vecino_igual = false;
-            int vecinos_validos = 0;
-
-            for(int d=0; d<4; ++d) {
-                int ni = i + dr[d];
-                int nj = j + dc[d];
-
-                // Verificar límites del mapa
-                if(ni >= 0 && ni < instancia.N_filas && nj >= 0 && nj < instancia.M_columnas) {
-                    vecinos_validos++;
-                    if(solucion.zonas_asignadas[ni][nj] == mi_zona) {
-                        tengo_vecino_igual = true;
-                        break; // Se encontro un vecino de la misma zona, NO es isla
-                    }
-                }
-            }
-
-            // Si tengo vecinos, pero NINGUNO es de mi zona -> SOY UNA ISLA
-            if (vecinos_validos > 0 && !tengo_vecino_igual) {
-                penalizacion_islas += M_ISLA;
-            }
-        }
+    if (opciones.poblacion && poblacion.generaciones == 0 && !hay_presupuesto) {
+        std::cerr << "--pob-generaciones 0 (sin limite) requiere --time-limit o --max-evals" << std::endl;
+        return 1;
     }
-
-
-
-    // Como estamos minimizando los valores, la penalización se suma al costo total
-    return costo_total + penalizacion_homogeneidad + penalizacion_islas;
-}
-
-// Algoritmo Hill Climbing 
-
-/**
- * @brief Implementa la búsqueda local Hill Climbing con estrategia "First Improvement".
- *
- * Explora el "vecindario" de la solución actual. El vecindario se define
- * cambiando la asignación de ZONA de UNA celda (i, j) a la vez.
- *
- * "First Improvement": Tan pronto como encuentra un movimiento (un "vecino")
- * que MEJORA (reduce) el costo, acepta ese movimiento y reinicia la
- * búsqueda desde la nueva solución.
- *
- * Continúa hasta que no se puede encontrar ninguna mejora en una pasada
- * completa (alcanza un óptimo local).
- *
- * @param instancia Los datos del problema.
- * @param sol_inicial La solución desde la cual comenzar la búsqueda.
- * @return La `Solucion` optimizada (óptimo local).
- */
-Solucion hill_climbing_first_improvement(const Instancia& instancia, Solucion sol_actual, double umbral_varianza) {
-    
-    sol_actual.costo = evaluar_solucion(instancia, sol_actual, umbral_varianza);
-
-    bool mejora_encontrada;
-    do {
-        mejora_encontrada = false;
-        bool restart = false;
-
-        // Iteramos por cada celda del terreno
-        for (int i = 0; i < instancia.N_filas && !restart; ++i) {
-            for (int j = 0; j < instancia.M_columnas && !restart; ++j) {
-                
-                int zona_original = sol_actual.zonas_asignadas[i][j];
-
-                // Probamos mover esta celda (i, j) a cada OTRA zona posible
-                for (int nueva_zona = 0; nueva_zona < instancia.num_zonas; ++nueva_zona) {
-                    
-                    if (nueva_zona == zona_original) continue;
-
-                    sol_actual.zonas_asignadas[i][j] = nueva_zona;
-                    
-                    double nuevo_costo = evaluar_solucion(instancia, sol_actual, umbral_varianza);
-
-                    // Este es el First 'Improvement' -> si mejora, aceptamos y salimos
-                    if (nuevo_costo < sol_actual.costo) {
-                        
-                        sol_actual.costo = nuevo_costo;
-                        restart = true;
-                        mejora_encontrada = true;
-                        break;
-                    } else {
-                        // Desahacer el movimiento
-                        sol_actual.zonas_asignadas[i][j] = zona_original;
-                    }
-                }
-            }
-        } 
-    } while (mejora_encontrada);
-    return sol_actual;
-}
-
-
-// Implementacion del Restart en First improvement
-
-/**
- * @brief Resuelve el problema usando Hill Climbing con Múltiples Restarts.
- *
- * Ejecuta el algoritmo `hill_climbing_first_improvement` un número
- * determinado de veces (`num_restarts`), cada vez comenzando desde
- * una solución inicial aleatoria diferente.
- *
- * Guarda y devuelve la MEJOR solución encontrada en todas las ejecuciones.
- *
- * @param instancia Los datos del problema.
- * @param num_restarts El número de veces que se reiniciará el algoritmo.
- * @return La mejor `Solucion` encontrada globalmente.
- */
-Solucion resolver_con_restart(const Instancia& instancia, int num_restarts, double umbral_varianza) {
-    
-    Solucion mejor_solucion_global(instancia.N_filas, instancia.M_columnas);
-    // std::cout << "Iniciando Hill Climbing con " << num_restarts << " restarts..." << std::endl;
-
-    for (int r = 0; r < num_restarts; ++r) {
-        
-        // Generamos una solución inicial con greedy
-        Solucion sol_inicial = generar_solucion_inicial_aleatoria(instancia);
-
-        // Mejoramos dicha solucion con Hill Climbing
-        Solucion sol_optimo_local = hill_climbing_first_improvement(instancia, sol_inicial, umbral_varianza);
-
-        // std::cout << "  Restart " << (r + 1) << "/" << num_restarts 
-        //           << " -> Costo (Con Penalización) " << sol_optimo_local.costo << std::endl;
-
-        // Comparamos con la mejor solución global encontrada hasta ahora
-        if (sol_optimo_local.costo < mejor_solucion_global.costo) {
-            mejor_solucion_global = sol_optimo_local;
-            std::cout << "  --> Nueva mejor solucion encontrada! " << std::endl;
-        }
+    if (opciones.poblacion && opciones.multinivel) {
+        std::cerr << "--poblacion no se combina con --multinivel" << std::endl;
+        return 1;
     }
-
-    return mejor_solucion_global;
-}
-
-/**
- * @brief Lee los datos del terreno desde un archivo de texto .spp
- * 
- * El archivo debe tener el siguiente formato:
- * 
- * * - La primera línea contiene dos enteros: m n (número de filas y columnas)
- * 
- * * - Las siguientes m líneas contienen n valores flotantes cada una,
- *   separados por espacios, representando los datos del terreno.
- */
-std::vector<std::vector<float>> leer_datos(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("No se pudo abrir el archivo: " + filename);
+    if (!restarts_fijados && hay_presupuesto) {
+        // Con presupuesto y sin --restarts: reiniciar hasta agotarlo
+        opciones.num_restarts = 0;
+    } else if (!restarts_fijados && !archivo_inicial.empty()) {
+        // Arranque en caliente: por defecto solo se reoptimiza la solución cargada
+        opciones.num_restarts = 1;
     }
 
-    int m, n;
-    file >> m >> n;
-    std::vector<std::vector<float>> datos(m, std::vector<float>(n));
-    for (int i = 0; i < m; ++i) {
-        for (int j = 0; j < n; ++j) {
-            file >> datos[i][j];
-        }
+    if (!semilla_fijada) {
+        std::random_device rd;
+        opciones.semilla = (static_cast<std::uint64_t>(rd()) << 32) | rd();
     }
-    return datos;
-}
-
-int main(int argc, char* argv[]) {
 
-    // Detectar bandera --no-gui
-    bool no_gui = false;
-    for(int i=0; i<argc; ++i) {
-        std::string s = argv[i];
-        if (s == "--no-gui") no_gui = true;
+    bool multibanda = !archivos_banda.empty() || pesos_banda.size() > 1;
+    if (multibanda && (opciones.multinivel || opciones.estrategia != EstrategiaBusqueda::FIRST_IMPROVEMENT ||
+                       validar_varianza)) {
+        std::cerr << "Con varias bandas solo se admite --estrategia first (sin --multinivel ni --validar-varianza)" << std::endl;
+        return 1;
     }
 
-    if (argc < 4) {
-        std::cerr << "Uso: " << argv[0] << " <archivo_datos.spp> <num_zonas> <alpha> [options]" << std::endl;
+    if (!archivo_inicial.empty() && opciones.multinivel) {
+        std::cerr << "--init-from no se combina con --multinivel" << std::endl;
         return 1;
     }
-    
+
+    if (modo_batch) {
+        if (!archivo_imagen.empty()) {
+            std::cerr << "--save no aplica a --batch (usar 'imagenes <directorio>' en el archivo de trabajos)" << std::endl;
+            return 1;
+        }
+        if (!archivo_solucion.empty() || !archivo_inicial.empty()) {
+            std::cerr << "--save-solution e --init-from no aplican a --batch" << std::endl;
+            return 1;
+        }
+        if (!archivos_banda.empty() || !pesos_banda.empty()) {
+            std::cerr << "--banda y --pesos no aplican a --batch (usar 'a.spp+b.spp' y 'pesos' en el archivo de trabajos)" << std::endl;
+            return 1;
+        }
+        try {
+            return ejecutar_batch(argv[2], opciones);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
     std::string archivo_datos = argv[1];
     int p_zonas = std::stoi(argv[2]);
     double alpha = std::stod(argv[3]);
-    
-    bool mostrar_etiquetas = false;
-    // Chequeo simple para el 4to argumento si no es --no-gui
-    if (argc >= 5) {
-        std::string arg = argv[4];
-        if (arg == "1" || arg == "true") mostrar_etiquetas = true;
+
+    if (p_zonas < 1 || p_zonas > MAX_ZONAS) {
+        std::cerr << "num_zonas debe estar entre 1 y " << MAX_ZONAS << std::endl;
+        return 1;
     }
 
-    auto datos = leer_datos("instances/" + archivo_datos);
-    Instancia instancia_problema(datos, p_zonas);
+    auto inicio_lectura = std::chrono::high_resolution_clock::now();
+    Instancia instancia_problema(Grid<float>(), p_zonas);
+    try {
+        // Banda 0: la instancia; --banda agrega las demás, cada una en su plano
+        std::vector<Grid<float>> bandas;
+        bandas.push_back(leer_datos("instances/" + archivo_datos, opciones.usar_cache));
+        for (const std::string& ruta : archivos_banda) {
+            bandas.push_back(leer_datos("instances/" + ruta, opciones.usar_cache));
+        }
+        if (pesos_banda.empty()) pesos_banda.assign(bandas.size(), 1.0);
+        instancia_problema = Instancia(std::move(bandas), std::move(pesos_banda), p_zonas);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    std::chrono::duration<double> tiempo_lectura = std::chrono::high_resolution_clock::now() - inicio_lectura;
 
     double varianza_total_S = calcular_varianza_total(instancia_problema);
     double umbral_varianza_max = alpha * varianza_total_S;
@@ -416,17 +282,55 @@ int main(int argc, char* argv[]) {
     if (!no_gui) {
         std::cout << "Instancia cargada: " << instancia_problema.N_filas << "x" << instancia_problema.M_columnas << std::endl;
         std::cout << "Varianza Total (Var(S)): " << varianza_total_S << std::endl;
+        if (instancia_problema.num_bandas() > 1) {
+            std::cout << "Bandas: " << instancia_problema.num_bandas() << " (pesos";
+            for (double w : instancia_problema.pesos) std::cout << " " << w;
+            std::cout << ")" << std::endl;
+        }
+        std::cout << "Hilos: " << opciones.num_hilos << std::endl;
+    }
+    std::cout << "Semilla: " << opciones.semilla << std::endl;
+
+    // Arranque en caliente desde una zonificación guardada (--init-from)
+    Solucion solucion_cargada(0, 0);
+    if (!archivo_inicial.empty()) {
+        try {
+            SolucionGuardada guardada = cargar_solucion(archivo_inicial);
+            const Grid<zona_t>& zonas = guardada.solucion.zonas_asignadas;
+            if (zonas.filas() != instancia_problema.N_filas || zonas.columnas() != instancia_problema.M_columnas) {
+                throw std::runtime_error(archivo_inicial + " es de " + std::to_string(zonas.filas()) + "x" +
+                                         std::to_string(zonas.columnas()) + " y la instancia de " +
+                                         std::to_string(instancia_problema.N_filas) + "x" +
+                                         std::to_string(instancia_problema.M_columnas));
+            }
+            if (guardada.num_zonas != p_zonas) {
+                throw std::runtime_error(archivo_inicial + " tiene " + std::to_string(guardada.num_zonas) +
+                                         " zonas y se pidieron " + std::to_string(p_zonas));
+            }
+            std::cout << "Solucion inicial: " << archivo_inicial << " (costo guardado " << guardada.solucion.costo
+                      << ", alpha " << guardada.alpha << ", semilla " << guardada.semilla << ")" << std::endl;
+            solucion_cargada = std::move(guardada.solucion);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        opciones.solucion_inicial = &solucion_cargada;
     }
     
-    int num_restarts = 20;
-
     // --- MEDICIÓN DE TIEMPO ---
     auto start_time = std::chrono::high_resolution_clock::now();
 
-    Solucion solucion_final = resolver_con_restart(
-                                    instancia_problema, 
-                                    num_restarts, 
-                                    umbral_varianza_max);
+    bool con_estadisticas = !opciones.archivo_estadisticas.empty();
+    EstadisticasEjecucion estadisticas;
+
+    Solucion solucion_final(0, 0);
+    try {
+        solucion_final = resolver_con_restart(instancia_problema, umbral_varianza_max, opciones,
+                                              con_estadisticas ? &estadisticas : nullptr);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
 
     auto end_time = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = end_time - start_time;
@@ -439,18 +343,71 @@ int main(int argc, char* argv[]) {
     std::cout << "Mejor Costo Final (con penalizacion): " << solucion_final.costo << std::endl;
     std::cout << "Tiempo de ejecucion: " << duration.count() << " segundos" << std::endl;
 
-    // Solo mostrar gráfico si NO estamos en modo script
-    if (!no_gui) {
-        std::vector<std::vector<int>> zonas_para_mostrar = solucion_final.zonas_asignadas;
-        for (int i = 0; i < instancia_problema.N_filas; ++i) {
-            for (int j = 0; j < instancia_problema.M_columnas; ++j) {
-                zonas_para_mostrar[i][j] += 1;
+    if (!archivo_solucion.empty()) {
+        try {
+            guardar_solucion(archivo_solucion, solucion_final, p_zonas, alpha, opciones.semilla);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        std::cout << "Solucion guardada en: " << archivo_solucion << std::endl;
+    }
+
+    if (validar_varianza) {
+        try {
+            validar_varianzas(instancia_problema, solucion_final, umbral_varianza_max);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (con_estadisticas) {
+        estadisticas.instancia = archivo_datos;
+        estadisticas.filas = instancia_problema.N_filas;
+        estadisticas.columnas = instancia_problema.M_columnas;
+        estadisticas.zonas = p_zonas;
+        estadisticas.alpha = alpha;
+        estadisticas.semilla = opciones.semilla;
+        estadisticas.hilos = opciones.num_hilos;
+        estadisticas.estrategia = nombre_estrategia(opciones.estrategia);
+        estadisticas.inicial = nombre_metodo_inicial(opciones.inicial);
+        estadisticas.motor = nombre_motor(opciones.motor);
+        estadisticas.tiempo_lectura = tiempo_lectura.count();
+        estadisticas.costo_final = solucion_final.costo;
+        estadisticas.memoria_pico_mb = memoria_pico_mb();
+        try {
+            guardar_estadisticas(opciones.archivo_estadisticas, {estadisticas});
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Solo mostrar gráfico si NO estamos en modo script; --save funciona sin display
+    if (!no_gui || !archivo_imagen.empty()) {
+        Grid<zona_t> zonas_para_mostrar = solucion_final.zonas_asignadas;
+        for (zona_t& zona : zonas_para_mostrar) {
+            zona += 1;
+        }
+        int factor = factorHeatmap(instancia_problema.N_filas, instancia_problema.M_columnas);
+
+        if (!archivo_imagen.empty()) {
+            try {
+                saveHeatmap(archivo_imagen, instancia_problema.datos_terreno, factor, zonas_para_mostrar,
+                            mostrar_etiquetas);
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                return 1;
             }
+            std::cout << "Imagen guardada en: " << archivo_imagen << std::endl;
+        }
+        if (!no_gui) {
+            std::cout << "Mostrando mapa de calor..." << std::endl;
+            plotHeatmap(instancia_problema.datos_terreno,
+                        factor,
+                        zonas_para_mostrar,
+                        mostrar_etiquetas);
         }
-        std::cout << "Mostrando mapa de calor..." << std::endl;
-        plotHeatmap(instancia_problema.datos_terreno, 
-                    30,
-                    zonas_para_mostrar,
-                    mostrar_etiquetas); 
     }
 }
\ No newline at end of file
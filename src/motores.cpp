@@ -0,0 +1,325 @@
+#include "motores.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "busqueda_lote.hpp"
+#include "conectividad.hpp"
+#include "estadisticas.hpp"
+#include "evaluacion_incremental.hpp"
+#include "frontera.hpp"
+#include "presupuesto.hpp"
+#include "teselas.hpp"
+
+namespace {
+
+// Vecinos muestreados para estimar la temperatura inicial del recocido
+constexpr int MUESTRA_TEMPERATURA = 200;
+
+// Cada cuántas iteraciones se purgan del mapa tabú los atributos vencidos
+constexpr long long PURGA_TABU = 1024;
+
+/**
+ * @brief Estado compartido por el recocido y la búsqueda tabú: evaluación
+ * incremental, frontera, chequeo de conectividad, presupuesto y el registro
+ * para volver a la mejor solución visitada.
+ *
+ * A diferencia del Hill Climbing, estos motores aceptan movimientos que
+ * empeoran, así que la solución actual no es la mejor. En vez de copiar el
+ * mapa en cada mejora se anotan los movimientos aceptados desde la última
+ * (celda y zona anterior); `terminar` los deshace en orden inverso.
+ */
+class Recorrido {
+public:
+    Recorrido(const Instancia& instancia, Solucion& sol, double umbral_varianza, bool verificar_delta,
+              Presupuesto* presupuesto, bool conexo)
+        : estado(instancia, sol, umbral_varianza, verificar_delta), frontera(sol.zonas_asignadas),
+          zonas(sol.zonas_asignadas), M(instancia.M_columnas), presupuesto(presupuesto),
+          mejor(estado.costo()) {
+        if (conexo) conectividad.emplace(instancia.N_filas, instancia.M_columnas);
+    }
+
+    EstadoEvaluacion estado;
+    FronteraZonas frontera;
+
+    /**
+     * @brief Celda de frontera al azar (índice lineal), o -1 si no hay frontera.
+     */
+    int celda_al_azar(std::mt19937& gen) const {
+        const std::vector<int>& celdas = frontera.celdas();
+        if (celdas.empty()) return -1;
+        return celdas[randint(gen, 0, static_cast<int>(celdas.size()) - 1)];
+    }
+
+    /**
+     * @brief true si la celda puede dejar su zona (siempre, sin --conexo).
+     */
+    bool puede_salir(int indice) {
+        if (!conectividad || conectividad->puede_salir(zonas, indice / M, indice % M)) return true;
+        ++estado.contadores().rechazos_conectividad;
+        return false;
+    }
+
+    /**
+     * @brief Cuenta un movimiento probado. Devuelve true si se agotó el presupuesto.
+     */
+    bool contar_evaluacion() {
+        ++estado.contadores().movimientos_probados;
+        if (!presupuesto || ++evaluaciones_locales < Presupuesto::LOTE_EVALUACIONES) return detenido;
+        detenido = presupuesto->consumir(evaluaciones_locales);
+        evaluaciones_locales = 0;
+        presupuesto->reportar_costo(mejor);
+        return detenido;
+    }
+
+    /**
+     * @brief Aplica el movimiento y, si es el mejor costo visitado, lo fija como
+     * nuevo punto de retorno.
+     */
+    void mover(int indice, int zona_destino) {
+        int i = indice / M;
+        int j = indice % M;
+        deshacer.push_back({indice, zonas[indice]});
+        estado.aplicar_movimiento(i, j, zona_destino);
+        frontera.actualizar_alrededor(i, j);
+
+        double costo = estado.costo();
+        if (costo < mejor - EPSILON_MEJORA) {
+            mejor = costo;
+            deshacer.clear();
+        }
+    }
+
+    double mejor_costo() const { return mejor; }
+
+    /**
+     * @brief Deshace los movimientos posteriores al mejor y vuelca los contadores.
+     */
+    void terminar() {
+        for (auto it = deshacer.rbegin(); it != deshacer.rend(); ++it) {
+            estado.aplicar_movimiento(it->celda / M, it->celda % M, it->zona);
+        }
+        deshacer.clear();
+
+        if (presupuesto) presupuesto->consumir(evaluaciones_locales);
+        evaluaciones_locales = 0;
+        contadores_hilo().sumar(estado.contadores());
+    }
+
+private:
+    struct Movimiento {
+        int celda;
+        zona_t zona;   // Zona que tenía antes del movimiento
+    };
+
+    Grid<zona_t>& zonas;
+    int M;
+    Presupuesto* presupuesto;
+    std::optional<ConectividadZonas> conectividad;
+    std::vector<Movimiento> deshacer;
+    double mejor;
+    long long evaluaciones_locales = 0;
+    bool detenido = false;
+};
+
+/**
+ * @brief Temperatura que acepta con probabilidad 1/2 el empeoramiento
+ * mediano de una muestra de vecinos de frontera.
+ */
+double estimar_temperatura(Recorrido& recorrido, const Grid<zona_t>& zonas, int M, std::mt19937& gen) {
+    std::vector<double> empeoramientos;
+    for (int k = 0; k < MUESTRA_TEMPERATURA; ++k) {
+        int indice = recorrido.celda_al_azar(gen);
+        if (indice < 0) break;
+        zona_t candidatas[4];
+        int num_candidatas = FronteraZonas::zonas_vecinas(zonas, indice / M, indice % M, candidatas);
+        if (num_candidatas == 0) continue;
+        int destino = candidatas[randint(gen, 0, num_candidatas - 1)];
+        double delta = recorrido.estado.delta_movimiento(indice / M, indice % M, destino);
+        if (delta > EPSILON_MEJORA) empeoramientos.push_back(delta);
+    }
+    if (empeoramientos.empty()) return 1.0;
+
+    auto mediana = empeoramientos.begin() + empeoramientos.size() / 2;
+    std::nth_element(empeoramientos.begin(), mediana, empeoramientos.end());
+    return *mediana / std::log(2.0);
+}
+
+} // namespace
+
+Solucion recocido_simulado(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                           const ParametrosRecocido& parametros, std::mt19937& gen,
+                           bool verificar_delta, Presupuesto* presupuesto, bool conexo) {
+    {
+        Recorrido recorrido(instancia, sol_actual, umbral_varianza, verificar_delta, presupuesto, conexo);
+        const Grid<zona_t>& zonas = sol_actual.zonas_asignadas;
+        const int M = instancia.M_columnas;
+
+        double temperatura = parametros.temperatura_inicial > 0.0
+                                 ? parametros.temperatura_inicial
+                                 : estimar_temperatura(recorrido, zonas, M, gen);
+        double temperatura_final = temperatura * parametros.temperatura_final_relativa;
+        int pasos = parametros.pasos_por_temperatura > 0
+                        ? parametros.pasos_por_temperatura
+                        : std::max(100, static_cast<int>(recorrido.frontera.celdas().size()));
+        std::uniform_real_distribution<double> uniforme(0.0, 1.0);
+
+        bool detenido = false;
+        while (temperatura > temperatura_final && !detenido) {
+            ++recorrido.estado.contadores().pasadas;
+            for (int paso = 0; paso < pasos && !detenido; ++paso) {
+                int indice = recorrido.celda_al_azar(gen);
+                if (indice < 0) break; // Una sola zona: no hay vecinos
+                if (!recorrido.puede_salir(indice)) continue;
+
+                int i = indice / M;
+                int j = indice % M;
+                zona_t candidatas[4];
+                int num_candidatas = FronteraZonas::zonas_vecinas(zonas, i, j, candidatas);
+                int destino = candidatas[randint(gen, 0, num_candidatas - 1)];
+
+                double delta = recorrido.estado.delta_movimiento(i, j, destino);
+                detenido = recorrido.contar_evaluacion();
+                if (delta <= 0.0 || uniforme(gen) < std::exp(-delta / temperatura)) {
+                    recorrido.mover(indice, destino);
+                }
+            }
+            temperatura *= parametros.enfriamiento;
+        }
+        recorrido.terminar();
+    }
+
+    // La mejor solución visitada no tiene por qué ser óptimo local
+    return hill_climbing_first_improvement(instancia, std::move(sol_actual), umbral_varianza, verificar_delta,
+                                           presupuesto, conexo);
+}
+
+Solucion busqueda_tabu(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                       const ParametrosTabu& parametros, std::mt19937& gen,
+                       bool verificar_delta, Presupuesto* presupuesto, bool conexo) {
+    {
+        Recorrido recorrido(instancia, sol_actual, umbral_varianza, verificar_delta, presupuesto, conexo);
+        const Grid<zona_t>& zonas = sol_actual.zonas_asignadas;
+        const int M = instancia.M_columnas;
+        const long long p = instancia.num_zonas;
+
+        int max_sin_mejora = parametros.max_sin_mejora > 0
+                                 ? parametros.max_sin_mejora
+                                 : std::max(1000, static_cast<int>(recorrido.frontera.celdas().size()));
+
+        // Atributo (celda, zona) -> iteración hasta la que es tabú volver
+        std::unordered_map<long long, long long> tabu_hasta;
+        auto es_tabu = [&](int celda, int zona, long long iteracion) {
+            auto it = tabu_hasta.find(celda * p + zona);
+            return it != tabu_hasta.end() && it->second > iteracion;
+        };
+
+        long long iteracion = 0;
+        int sin_mejora = 0;
+        bool detenido = false;
+        while (sin_mejora < max_sin_mejora && !detenido) {
+            ++iteracion;
+            ++recorrido.estado.contadores().pasadas;
+            double costo_actual = recorrido.estado.costo();
+            double mejor_antes = recorrido.mejor_costo();
+
+            // Mejor movimiento permitido entre las celdas muestreadas
+            int mejor_celda = -1;
+            int mejor_destino = -1;
+            double mejor_delta = std::numeric_limits<double>::infinity();
+            for (int k = 0; k < parametros.candidatos && !detenido; ++k) {
+                int indice = recorrido.celda_al_azar(gen);
+                if (indice < 0) break;
+                if (!recorrido.puede_salir(indice)) continue;
+
+                int i = indice / M;
+                int j = indice % M;
+                zona_t candidatas[4];
+                int num_candidatas = FronteraZonas::zonas_vecinas(zonas, i, j, candidatas);
+                for (int c = 0; c < num_candidatas; ++c) {
+                    double delta = recorrido.estado.delta_movimiento(i, j, candidatas[c]);
+                    detenido = recorrido.contar_evaluacion();
+                    if (delta >= mejor_delta) continue;
+                    bool aspiracion = costo_actual + delta < mejor_antes - EPSILON_MEJORA;
+                    if (!es_tabu(indice, candidatas[c], iteracion) || aspiracion) {
+                        mejor_celda = indice;
+                        mejor_destino = candidatas[c];
+                        mejor_delta = delta;
+                    }
+                }
+            }
+
+            if (mejor_celda >= 0) {
+                tabu_hasta[mejor_celda * p + zonas[mejor_celda]] = iteracion + parametros.tenencia;
+                recorrido.mover(mejor_celda, mejor_destino);
+            }
+            sin_mejora = (recorrido.mejor_costo() < mejor_antes) ? 0 : sin_mejora + 1;
+
+            if (iteracion % PURGA_TABU == 0) {
+                for (auto it = tabu_hasta.begin(); it != tabu_hasta.end();) {
+                    it = (it->second <= iteracion) ? tabu_hasta.erase(it) : std::next(it);
+                }
+            }
+        }
+        recorrido.terminar();
+    }
+
+    return hill_climbing_first_improvement(instancia, std::move(sol_actual), umbral_varianza, verificar_delta,
+                                           presupuesto, conexo);
+}
+
+Solucion mejorar_solucion(const Instancia& instancia, Solucion sol_inicial, double umbral_varianza,
+                          const OpcionesBusqueda& opciones, std::mt19937& gen, Presupuesto* presupuesto) {
+    Solucion sol_local = [&] {
+        switch (opciones.estrategia) {
+            case EstrategiaBusqueda::BEST_IMPROVEMENT:
+                return hill_climbing_best_improvement(instancia, std::move(sol_inicial), umbral_varianza,
+                                                      opciones.num_hilos, opciones.verificar_delta, presupuesto,
+                                                      opciones.conexo);
+            case EstrategiaBusqueda::TESELAS:
+                return hill_climbing_teselas(instancia, std::move(sol_inicial), umbral_varianza, opciones.num_hilos,
+                                             opciones.lado_tesela, opciones.verificar_delta, presupuesto,
+                                             opciones.conexo);
+            case EstrategiaBusqueda::FIRST_IMPROVEMENT:
+            default:
+                return hill_climbing_first_improvement(instancia, std::move(sol_inicial), umbral_varianza,
+                                                       opciones.verificar_delta, presupuesto, opciones.conexo);
+        }
+    }();
+    if (presupuesto && presupuesto->agotado()) return sol_local;
+
+    switch (opciones.motor) {
+        case MotorBusqueda::SA:
+            return recocido_simulado(instancia, std::move(sol_local), umbral_varianza, opciones.recocido, gen,
+                                     opciones.verificar_delta, presupuesto, opciones.conexo);
+        case MotorBusqueda::TABU:
+            return busqueda_tabu(instancia, std::move(sol_local), umbral_varianza, opciones.tabu, gen,
+                                 opciones.verificar_delta, presupuesto, opciones.conexo);
+        case MotorBusqueda::HC:
+        default:
+            return sol_local;
+    }
+}
+
+const char* nombre_estrategia(EstrategiaBusqueda estrategia) {
+    switch (estrategia) {
+        case EstrategiaBusqueda::BEST_IMPROVEMENT: return "best";
+        case EstrategiaBusqueda::TESELAS: return "teselas";
+        case EstrategiaBusqueda::FIRST_IMPROVEMENT:
+        default: return "first";
+    }
+}
+
+const char* nombre_motor(MotorBusqueda motor) {
+    switch (motor) {
+        case MotorBusqueda::SA: return "sa";
+        case MotorBusqueda::TABU: return "tabu";
+        case MotorBusqueda::HC:
+        default: return "hc";
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <random>
+#include "spp.hpp"
+
+/**
+ * @brief Recocido simulado desde `sol_actual` (normalmente un óptimo local).
+ *
+ * En cada paso elige al azar una celda de frontera y una de sus zonas
+ * vecinas; el movimiento se acepta si mejora, o con probabilidad
+ * exp(-delta / T) si empeora. La temperatura baja geométricamente
+ * (`T *= enfriamiento`) tras `pasos_por_temperatura` pasos, desde `T0`
+ * hasta `T0 * temperatura_final_relativa`. Con `temperatura_inicial = 0`,
+ * T0 se estima para aceptar la mitad de las veces el empeoramiento mediano
+ * de una muestra de vecinos.
+ *
+ * Guarda la mejor solución visitada con un registro de deshacer (los
+ * movimientos aceptados desde el último mejor): mejorar cuesta O(1), no una
+ * copia del mapa. Al final vuelve a esa solución y la pule con First
+ * Improvement.
+ */
+Solucion recocido_simulado(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                           const ParametrosRecocido& parametros, std::mt19937& gen,
+                           bool verificar_delta = false, Presupuesto* presupuesto = nullptr, bool conexo = false);
+
+/**
+ * @brief Búsqueda tabú desde `sol_actual` (normalmente un óptimo local).
+ *
+ * En cada iteración muestrea `candidatos` celdas de frontera, puntúa todos
+ * sus movimientos a zonas vecinas y aplica el mejor permitido, aunque
+ * empeore. Al sacar la celda c de la zona a, el atributo (c, a) queda tabú
+ * por `tenencia` iteraciones: la celda no puede volver a esa zona. Un
+ * movimiento tabú se permite igual si lleva a un costo mejor que el mejor
+ * visitado (criterio de aspiración). Termina tras `max_sin_mejora`
+ * iteraciones sin mejorar el mejor (0 = automático según la frontera).
+ *
+ * Igual que el recocido, vuelve a la mejor solución visitada y la pule con
+ * First Improvement.
+ */
+Solucion busqueda_tabu(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                       const ParametrosTabu& parametros, std::mt19937& gen,
+                       bool verificar_delta = false, Presupuesto* presupuesto = nullptr, bool conexo = false);
+
+/**
+ * @brief Búsqueda local de un restart según `opciones.motor`.
+ *
+ * Siempre desciende primero con Hill Climbing (first, best o teselas según
+ * `opciones.estrategia`); con SA o TABU continúa desde ese óptimo local con
+ * el recocido o la búsqueda tabú. `gen` es el generador del restart.
+ */
+Solucion mejorar_solucion(const Instancia& instancia, Solucion sol_inicial, double umbral_varianza,
+                          const OpcionesBusqueda& opciones, std::mt19937& gen, Presupuesto* presupuesto = nullptr);
+
+/**
+ * @brief Nombre de la estrategia tal como se pasa a `--estrategia`.
+ */
+const char* nombre_estrategia(EstrategiaBusqueda estrategia);
+
+/**
+ * @brief Nombre del motor tal como se pasa a `--engine`.
+ */
+const char* nombre_motor(MotorBusqueda motor);
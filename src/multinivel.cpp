@@ -0,0 +1,457 @@
+#include "multinivel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "conectividad.hpp"
+#include "estadisticas.hpp"
+#include "frontera.hpp"
+#include "inicializacion.hpp"
+#include "presupuesto.hpp"
+
+namespace {
+
+// Con --multinivel automático, el nivel más grueso conserva al menos estas
+// celdas por zona (menos y las zonas quedan de pocos bloques, sin forma)
+constexpr int MIN_CELDAS_POR_ZONA = 32;
+
+// Direcciones para vecinos: Arriba, Abajo, Izquierda, Derecha
+const int dr[] = {-1, 1, 0, 0};
+const int dc[] = {0, 0, -1, 1};
+
+Nivel agregar_bloques(const Nivel& fino) {
+    Nivel grueso;
+    grueso.filas = (fino.filas + 1) / 2;
+    grueso.columnas = (fino.columnas + 1) / 2;
+    grueso.bloques.assign(static_cast<std::size_t>(grueso.filas) * grueso.columnas, MomentosVarianza());
+
+    for (int i = 0; i < fino.filas; ++i) {
+        int base_fina = i * fino.columnas;
+        int base_gruesa = (i / 2) * grueso.columnas;
+        for (int j = 0; j < fino.columnas; ++j) {
+            int f = base_fina + j;
+            int g = base_gruesa + j / 2;
+            grueso.bloques[g].combinar(fino.momentos_en(f));
+        }
+    }
+    return grueso;
+}
+
+// Valor representativo de cada bloque, para las soluciones iniciales
+Grid<float> medias_de(const Nivel& nivel) {
+    Grid<float> medias(nivel.filas, nivel.columnas);
+    for (std::size_t k = 0; k < medias.size(); ++k) {
+        medias[k] = static_cast<float>(nivel.bloques[k].media);
+    }
+    return medias;
+}
+
+/**
+ * @brief Igual que `EstadoEvaluacion`, pero cada celda del nivel aporta los
+ * momentos de su bloque en vez de un solo valor, y cada zona guarda sus
+ * momentos (media y M2, no suma de cuadrados): mover un bloque es
+ * `quitar` de una zona y `combinar` en otra. Las islas se cuentan sobre los
+ * bloques del nivel.
+ */
+class EstadoNivel {
+public:
+    EstadoNivel(const Nivel& nivel, Grid<zona_t>& zonas, int num_zonas, double umbral_varianza)
+        : nivel(nivel), zonas(zonas), umbral_varianza(umbral_varianza),
+          por_zona(num_zonas), costo_zona(num_zonas, 0.0), num_islas(0) {
+        for (int i = 0; i < nivel.filas; ++i) {
+            for (int j = 0; j < nivel.columnas; ++j) {
+                int indice = i * nivel.columnas + j;
+                int k = zonas[indice];
+                por_zona[k].combinar(nivel.momentos_en(indice));
+                if (es_isla(i, j, i, j, k)) num_islas++;
+            }
+        }
+        for (int k = 0; k < num_zonas; ++k) {
+            costo_zona[k] = costo_de_zona(por_zona[k]);
+        }
+    }
+
+    double costo() const {
+        double total = 0.0;
+        for (double c : costo_zona) total += c;
+        return total + num_islas * M_ISLA;
+    }
+
+    double delta_movimiento(int i, int j, int zona_destino) {
+        ++cuenta.evaluaciones_delta;
+        int indice = i * nivel.columnas + j;
+        int zona_origen = zonas[indice];
+        if (zona_origen == zona_destino) return 0.0;
+
+        MomentosVarianza bloque = nivel.momentos_en(indice);
+        MomentosVarianza origen = por_zona[zona_origen];
+        MomentosVarianza destino = por_zona[zona_destino];
+        origen.quitar(bloque);
+        destino.combinar(bloque);
+
+        double nuevo_origen = costo_de_zona(origen);
+        double nuevo_destino = costo_de_zona(destino);
+        return (nuevo_origen - costo_zona[zona_origen]) + (nuevo_destino - costo_zona[zona_destino]) +
+               delta_islas(i, j, zona_destino) * M_ISLA;
+    }
+
+    void aplicar_movimiento(int i, int j, int zona_destino) {
+        int indice = i * nivel.columnas + j;
+        int zona_origen = zonas[indice];
+        if (zona_origen == zona_destino) return;
+        ++cuenta.movimientos_aceptados;
+
+        MomentosVarianza bloque = nivel.momentos_en(indice);
+
+        num_islas += delta_islas(i, j, zona_destino);
+        zonas[indice] = static_cast<zona_t>(zona_destino);
+
+        por_zona[zona_origen].quitar(bloque);
+        por_zona[zona_destino].combinar(bloque);
+
+        costo_zona[zona_origen] = costo_de_zona(por_zona[zona_origen]);
+        costo_zona[zona_destino] = costo_de_zona(por_zona[zona_destino]);
+    }
+
+    ContadoresBusqueda cuenta;
+
+private:
+    const Nivel& nivel;
+    Grid<zona_t>& zonas;
+    double umbral_varianza;
+
+    std::vector<MomentosVarianza> por_zona;
+    std::vector<double> costo_zona;
+    int num_islas;
+
+    double costo_de_zona(const MomentosVarianza& zona) const {
+        double varianza = zona.varianza();
+
+        double costo = varianza;
+        if (varianza > umbral_varianza) {
+            costo += (varianza - umbral_varianza) * PENALIZACION_HOMOGENEIDAD;
+        }
+        return costo;
+    }
+
+    bool es_isla(int ci, int cj, int i, int j, int zona_ij) const {
+        auto zona_en = [&](int r, int c) {
+            return (r == i && c == j) ? zona_ij : static_cast<int>(zonas(r, c));
+        };
+
+        int mi_zona = zona_en(ci, cj);
+        int vecinos_validos = 0;
+        for (int d = 0; d < 4; ++d) {
+            int ni = ci + dr[d];
+            int nj = cj + dc[d];
+            if (ni >= 0 && ni < nivel.filas && nj >= 0 && nj < nivel.columnas) {
+                vecinos_validos++;
+                if (zona_en(ni, nj) == mi_zona) return false;
+            }
+        }
+        return vecinos_validos > 0;
+    }
+
+    int islas_locales(int i, int j, int zona_ij) const {
+        int total = es_isla(i, j, i, j, zona_ij) ? 1 : 0;
+        for (int d = 0; d < 4; ++d) {
+            int ni = i + dr[d];
+            int nj = j + dc[d];
+            if (ni >= 0 && ni < nivel.filas && nj >= 0 && nj < nivel.columnas) {
+                if (es_isla(ni, nj, i, j, zona_ij)) total++;
+            }
+        }
+        return total;
+    }
+
+    int delta_islas(int i, int j, int zona_destino) const {
+        int zona_origen = zonas(i, j);
+        if (zona_origen == zona_destino) return 0;
+        return islas_locales(i, j, zona_destino) - islas_locales(i, j, zona_origen);
+    }
+};
+
+/**
+ * @brief Hill Climbing first improvement sobre un nivel, solo con celdas de
+ * frontera (cola de trabajo como `hill_climbing_first_improvement`, sin la
+ * pasada sobre el vecindario completo). Devuelve el costo del nivel.
+ */
+double descenso_nivel(const Nivel& nivel, Grid<zona_t>& zonas, int num_zonas, double umbral_varianza, bool conexo,
+                      Presupuesto* presupuesto) {
+    EstadoNivel estado(nivel, zonas, num_zonas, umbral_varianza);
+    FronteraZonas frontera(zonas);
+    std::optional<ConectividadZonas> conectividad;
+    if (conexo) conectividad.emplace(nivel.filas, nivel.columnas);
+
+    const int N = nivel.filas;
+    const int M = nivel.columnas;
+    std::deque<int> pendientes;
+    std::vector<char> en_cola(zonas.size(), 0);
+
+    auto encolar = [&](int indice) {
+        if (!en_cola[indice] && frontera.contiene(indice)) {
+            en_cola[indice] = 1;
+            pendientes.push_back(indice);
+        }
+    };
+
+    long long evaluaciones_locales = 0;
+    bool detenido = false;
+    auto contar_evaluacion = [&]() {
+        ++estado.cuenta.movimientos_probados;
+        if (!presupuesto || ++evaluaciones_locales < Presupuesto::LOTE_EVALUACIONES) return;
+        detenido = presupuesto->consumir(evaluaciones_locales);
+        evaluaciones_locales = 0;
+    };
+
+    bool mejora_encontrada = true;
+    while (!detenido) {
+        if (pendientes.empty()) {
+            if (!mejora_encontrada) break; // Pasada completa sin mejoras -> óptimo local
+            mejora_encontrada = false;
+            ++estado.cuenta.pasadas;
+            for (int indice : frontera.celdas()) encolar(indice);
+            continue;
+        }
+
+        int indice = pendientes.front();
+        pendientes.pop_front();
+        en_cola[indice] = 0;
+
+        int i = indice / M;
+        int j = indice % M;
+        if (conectividad && !conectividad->puede_salir(zonas, i, j)) {
+            ++estado.cuenta.rechazos_conectividad;
+            continue;
+        }
+
+        zona_t candidatas[4];
+        int num_candidatas = FronteraZonas::zonas_vecinas(zonas, i, j, candidatas);
+        for (int c = 0; c < num_candidatas && !detenido; ++c) {
+            double delta = estado.delta_movimiento(i, j, candidatas[c]);
+            contar_evaluacion();
+            if (delta < -EPSILON_MEJORA) {
+                estado.aplicar_movimiento(i, j, candidatas[c]);
+                frontera.actualizar_alrededor(i, j);
+                encolar(indice);
+                if (i > 0) encolar(indice - M);
+                if (i + 1 < N) encolar(indice + M);
+                if (j > 0) encolar(indice - 1);
+                if (j + 1 < M) encolar(indice + 1);
+                mejora_encontrada = true;
+                break;
+            }
+        }
+    }
+    if (presupuesto) presupuesto->consumir(evaluaciones_locales);
+    contadores_hilo().sumar(estado.cuenta);
+    return estado.costo();
+}
+
+} // namespace
+
+std::vector<Nivel> construir_piramide(const Instancia& instancia, int max_niveles) {
+    std::vector<Nivel> piramide(1);
+    piramide[0].filas = instancia.N_filas;
+    piramide[0].columnas = instancia.M_columnas;
+    piramide[0].valores = &instancia.datos_terreno;
+
+    long long minimo = max_niveles > 0 ? instancia.num_zonas
+                                       : static_cast<long long>(MIN_CELDAS_POR_ZONA) * instancia.num_zonas;
+    while (max_niveles <= 0 || static_cast<int>(piramide.size()) <= max_niveles) {
+        const Nivel& actual = piramide.back();
+        if (actual.filas < 2 && actual.columnas < 2) break;
+        long long siguiente = static_cast<long long>((actual.filas + 1) / 2) * ((actual.columnas + 1) / 2);
+        if (siguiente < minimo) break;
+        piramide.push_back(agregar_bloques(actual));
+    }
+    return piramide;
+}
+
+Grid<zona_t> proyectar_zonas(const Grid<zona_t>& gruesa, int filas, int columnas) {
+    Grid<zona_t> fina(filas, columnas);
+    for (int i = 0; i < filas; ++i) {
+        const zona_t* origen = gruesa.fila(i / 2);
+        zona_t* destino = fina.fila(i);
+        for (int j = 0; j < columnas; ++j) destino[j] = origen[j / 2];
+    }
+    return fina;
+}
+
+Solucion resolver_multinivel(const Instancia& instancia, double umbral_varianza, const OpcionesBusqueda& opciones,
+                             EstadisticasEjecucion* estadisticas) {
+    using reloj = std::chrono::steady_clock;
+    auto segundos_desde = [](reloj::time_point t) { return std::chrono::duration<double>(reloj::now() - t).count(); };
+    auto inicio_busqueda = reloj::now();
+
+    const int p = instancia.num_zonas;
+    std::vector<Nivel> piramide = construir_piramide(instancia, opciones.niveles);
+    if (piramide.size() == 1) {
+        // Mapa demasiado chico para agregar: búsqueda normal
+        OpcionesBusqueda sin_niveles = opciones;
+        sin_niveles.multinivel = false;
+        return resolver_con_restart(instancia, umbral_varianza, sin_niveles, estadisticas);
+    }
+    const Nivel& grueso = piramide.back();
+
+    // Las soluciones iniciales se construyen sobre las medias de los bloques
+    Instancia instancia_gruesa(medias_de(grueso), p);
+    if (opciones.reportar_mejoras) {
+        std::cout << "Multinivel: " << piramide.size() << " niveles (" << instancia.N_filas << "x"
+                  << instancia.M_columnas << " -> " << grueso.filas << "x" << grueso.columnas << ")" << std::endl;
+    }
+
+    struct MejorLocal {
+        Grid<zona_t> zonas;
+        double costo;
+        int restart;
+        std::vector<std::pair<int, double>> costo_por_restart;
+        std::vector<EstadisticasRestart> estadisticas;
+    };
+
+    Presupuesto presupuesto(opciones.limite_tiempo, opciones.max_evaluaciones, opciones.archivo_traza);
+    int num_restarts = opciones.num_restarts > 0 ? opciones.num_restarts : std::numeric_limits<int>::max();
+    int num_hilos = std::max(1, std::min(opciones.num_hilos, num_restarts));
+
+    std::vector<MejorLocal> mejores(num_hilos, MejorLocal{Grid<zona_t>(), std::numeric_limits<double>::infinity(), -1, {}, {}});
+    std::atomic<int> siguiente_restart{0};
+
+    auto worker = [&](int id_hilo) {
+        MejorLocal& mejor = mejores[id_hilo];
+        while (!presupuesto.agotado()) {
+            int r = siguiente_restart++;
+            if (r >= num_restarts || r < 0) break;
+            std::mt19937 gen = generador_para(opciones.semilla, r);
+            EstadisticasRestart registro;
+            reloj::time_point t0;
+            if (estadisticas) {
+                contadores_hilo() = ContadoresBusqueda();
+                t0 = reloj::now();
+            }
+
+            Solucion sol = generar_solucion_inicial(instancia_gruesa, gen, opciones.inicial);
+            if (opciones.conexo) reparar_conectividad(sol, p);
+
+            if (estadisticas) {
+                registro.restart = r;
+                registro.tiempo_inicial = segundos_desde(t0);
+                registro.costo_inicial = EstadoNivel(grueso, sol.zonas_asignadas, p, umbral_varianza).costo();
+                t0 = reloj::now();
+            }
+
+            double costo = descenso_nivel(grueso, sol.zonas_asignadas, p, umbral_varianza, opciones.conexo,
+                                          &presupuesto);
+            presupuesto.reportar_costo(costo);
+            mejor.costo_por_restart.emplace_back(r, costo);
+            if (estadisticas) {
+                registro.tiempo_busqueda = segundos_desde(t0);
+                registro.costo_final = costo;
+                registro.contadores = contadores_hilo();
+                mejor.estadisticas.push_back(registro);
+            }
+
+            if (costo < mejor.costo || (costo == mejor.costo && r < mejor.restart)) {
+                mejor.zonas = std::move(sol.zonas_asignadas);
+                mejor.costo = costo;
+                mejor.restart = r;
+            }
+        }
+    };
+
+    if (num_hilos == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> hilos;
+        for (int t = 0; t < num_hilos; ++t) hilos.emplace_back(worker, t);
+        for (auto& h : hilos) h.join();
+    }
+
+    std::vector<std::pair<int, double>> costo_por_restart;
+    for (const auto& m : mejores) {
+        costo_por_restart.insert(costo_por_restart.end(), m.costo_por_restart.begin(), m.costo_por_restart.end());
+    }
+    std::sort(costo_por_restart.begin(), costo_por_restart.end());
+
+    double mejor_costo = std::numeric_limits<double>::infinity();
+    for (std::size_t k = 0; k < costo_por_restart.size() && opciones.reportar_mejoras; ++k) {
+        if (costo_por_restart[k].second < mejor_costo) {
+            mejor_costo = costo_por_restart[k].second;
+            std::cout << "  --> Nueva mejor solucion encontrada! " << std::endl;
+        }
+    }
+    if (opciones.reportar_mejoras && (opciones.limite_tiempo > 0.0 || opciones.max_evaluaciones > 0)) {
+        std::cout << "Restarts ejecutados: " << costo_por_restart.size()
+                  << " (" << presupuesto.evaluaciones() << " evaluaciones)" << std::endl;
+    }
+
+    MejorLocal* mejor_global = &mejores[0];
+    for (auto& m : mejores) {
+        if (m.restart < 0) continue;
+        if (mejor_global->restart < 0 || m.costo < mejor_global->costo ||
+            (m.costo == mejor_global->costo && m.restart < mejor_global->restart)) {
+            mejor_global = &m;
+        }
+    }
+    if (mejor_global->restart < 0) {
+        // El presupuesto se agotó antes del primer restart: al menos uno, sin descenso
+        std::mt19937 gen = generador_para(opciones.semilla, 0);
+        Solucion sol = generar_solucion_inicial(instancia_gruesa, gen, opciones.inicial);
+        if (opciones.conexo) reparar_conectividad(sol, p);
+        mejor_global->zonas = std::move(sol.zonas_asignadas);
+        mejor_global->restart = 0;
+    }
+
+    // Refinamiento: proyectar y mover solo celdas de frontera en cada nivel
+    auto inicio_refinamiento = reloj::now();
+    if (estadisticas) contadores_hilo() = ContadoresBusqueda();
+    Grid<zona_t> zonas = std::move(mejor_global->zonas);
+    double costo_nivel = 0.0;
+    for (int nivel = static_cast<int>(piramide.size()) - 2; nivel >= 0; --nivel) {
+        zonas = proyectar_zonas(zonas, piramide[nivel].filas, piramide[nivel].columnas);
+        costo_nivel = descenso_nivel(piramide[nivel], zonas, p, umbral_varianza, opciones.conexo, nullptr);
+    }
+
+    Solucion solucion(instancia.N_filas, instancia.M_columnas);
+    solucion.zonas_asignadas = std::move(zonas);
+    solucion.costo = evaluar_solucion(instancia, solucion, umbral_varianza);
+    presupuesto.reportar_costo(solucion.costo);
+
+    if (opciones.verificar_delta) {
+        double tolerancia = 1e-6 * std::max(1.0, std::fabs(solucion.costo));
+        if (std::fabs(costo_nivel - solucion.costo) > tolerancia) {
+            throw std::runtime_error("Costo multinivel inconsistente: incremental = " + std::to_string(costo_nivel) +
+                                     ", evaluar_solucion = " + std::to_string(solucion.costo));
+        }
+        if (opciones.conexo && !zonas_conexas(solucion.zonas_asignadas, p)) {
+            throw std::runtime_error("El refinamiento multinivel desconecto una zona");
+        }
+    }
+
+    if (estadisticas) {
+        estadisticas->restarts.clear();
+        for (const auto& m : mejores) {
+            estadisticas->restarts.insert(estadisticas->restarts.end(), m.estadisticas.begin(), m.estadisticas.end());
+        }
+        std::sort(estadisticas->restarts.begin(), estadisticas->restarts.end(),
+                  [](const EstadisticasRestart& a, const EstadisticasRestart& b) { return a.restart < b.restart; });
+
+        // El refinamiento se carga al restart ganador: es la continuación de su descenso
+        for (auto& r : estadisticas->restarts) {
+            if (r.restart != mejor_global->restart) continue;
+            r.tiempo_busqueda += segundos_desde(inicio_refinamiento);
+            r.costo_final = solucion.costo;
+            r.contadores.sumar(contadores_hilo());
+        }
+        estadisticas->tiempo_busqueda = segundos_desde(inicio_busqueda);
+    }
+    return solucion;
+}
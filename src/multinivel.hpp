@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include "spp.hpp"
+#include "varianza.hpp"
+
+/**
+ * @struct Nivel
+ * @brief Un nivel de la pirámide multinivel: cada celda es un bloque de
+ * celdas del mapa original.
+ *
+ * Por bloque se guardan los momentos (conteo, media y M2) de sus celdas
+ * originales, combinados con la fórmula de Chan como en varianza.hpp. Con
+ * eso la varianza de una zona formada por bloques es exactamente la de las
+ * celdas originales que cubre (no la de las medias de los bloques), sin
+ * restar sum(x^2)/n - media^2. En el nivel 0 (el mapa mismo) `bloques`
+ * queda vacío y los valores se leen directo de `valores`.
+ */
+struct Nivel {
+    int filas = 0;
+    int columnas = 0;
+    const Grid<float>* valores = nullptr;   // Solo en el nivel 0
+    std::vector<MomentosVarianza> bloques;
+
+    MomentosVarianza momentos_en(int indice) const {
+        if (!valores) return bloques[indice];
+        return MomentosVarianza{1, static_cast<double>((*valores)[indice]), 0.0};
+    }
+};
+
+/**
+ * @brief Pirámide de niveles agregando bloques de 2x2 (los bordes impares
+ * quedan con bloques de 1x2, 2x1 o 1x1). `piramide[0]` es el mapa original.
+ *
+ * Con `max_niveles = 0` se agrega mientras el nivel siguiente tenga al menos
+ * `MIN_CELDAS_POR_ZONA` celdas por zona; si no, se agregan a lo más
+ * `max_niveles` veces. Nunca se baja de `num_zonas` celdas.
+ */
+std::vector<Nivel> construir_piramide(const Instancia& instancia, int max_niveles = 0);
+
+/**
+ * @brief Lleva una zonificación de un nivel al siguiente más fino: cada
+ * celda fina hereda la zona de su bloque. Conserva la 4-conexidad de las zonas.
+ */
+Grid<zona_t> proyectar_zonas(const Grid<zona_t>& gruesa, int filas, int columnas);
+
+/**
+ * @brief Resuelve en modo multinivel (engrosar, resolver, refinar).
+ *
+ * 1. Construye la pirámide de bloques 2x2.
+ * 2. Ejecuta los restarts (solución inicial + Hill Climbing first
+ *    improvement ponderado por bloque) en el nivel más grueso, con los mismos
+ *    hilos, semilla y presupuesto que `resolver_con_restart`.
+ * 3. Proyecta la mejor zonificación nivel por nivel hasta el mapa original y
+ *    en cada nivel la refina moviendo solo celdas de frontera.
+ *
+ * El costo de cada nivel usa la varianza exacta de las celdas originales;
+ * solo las islas se cuentan por bloque. El refinamiento parte de la
+ * frontera proyectada y no recorre el vecindario completo, así que el
+ * trabajo total crece casi linealmente con N*M.
+ *
+ * El presupuesto (tiempo/evaluaciones) limita los restarts del nivel
+ * grueso; el refinamiento siempre se completa, porque sin él la solución
+ * queda con bordes en escalones de 2^L celdas.
+ */
+Solucion resolver_multinivel(const Instancia& instancia, double umbral_varianza, const OpcionesBusqueda& opciones,
+                             EstadisticasEjecucion* estadisticas = nullptr);
@@ -0,0 +1,298 @@
+#include "poblacion.hpp"
+#include "barrido.hpp"
+#include "conectividad.hpp"
+#include "estadisticas.hpp"
+#include "inicializacion.hpp"
+#include "motores.hpp"
+#include "presupuesto.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Celda del hijo todavía sin zona (las etiquetas válidas van de 0 a MAX_ZONAS - 1)
+constexpr zona_t SIN_ZONA = std::numeric_limits<zona_t>::max();
+
+/**
+ * @brief Buzón de un solo migrante entre dos subpoblaciones.
+ *
+ * `enviar` publica una copia con `exchange` y libera la que nadie recibió;
+ * `recibir` saca el puntero con `exchange(nullptr)` y se queda con él. Como
+ * cada puntero lo tiene un solo dueño a la vez, no hace falta lock ni
+ * conteo de referencias.
+ */
+class BuzonMigracion {
+public:
+    BuzonMigracion() = default;
+    BuzonMigracion(const BuzonMigracion&) = delete;
+    BuzonMigracion& operator=(const BuzonMigracion&) = delete;
+    ~BuzonMigracion() { delete migrante.load(std::memory_order_acquire); }
+
+    void enviar(const Solucion& solucion) {
+        delete migrante.exchange(new Solucion(solucion), std::memory_order_acq_rel);
+    }
+
+    std::unique_ptr<Solucion> recibir() {
+        return std::unique_ptr<Solucion>(migrante.exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+private:
+    std::atomic<Solucion*> migrante{nullptr};
+};
+
+struct Subpoblacion {
+    std::vector<Solucion> individuos;
+    int hijos = 0;
+    int hijos_aceptados = 0;
+    int migrantes_aceptados = 0;
+    std::vector<EstadisticasRestart> estadisticas;
+};
+
+// El candidato reemplaza al peor individuo si lo supera y su costo no está repetido
+bool insertar(std::vector<Solucion>& individuos, const Solucion& candidato) {
+    std::size_t peor = 0;
+    for (std::size_t k = 0; k < individuos.size(); ++k) {
+        if (individuos[k].costo == candidato.costo) return false;
+        if (individuos[k].costo > individuos[peor].costo) peor = k;
+    }
+    if (!(candidato.costo < individuos[peor].costo)) return false;
+    individuos[peor] = candidato;
+    return true;
+}
+
+std::size_t indice_mejor(const std::vector<Solucion>& individuos) {
+    std::size_t mejor = 0;
+    for (std::size_t k = 1; k < individuos.size(); ++k) {
+        if (individuos[k].costo < individuos[mejor].costo) mejor = k;
+    }
+    return mejor;
+}
+
+} // namespace
+
+Solucion cruzar_regiones(const Instancia& instancia, const Solucion& a, const Solucion& b, double umbral_varianza,
+                         std::mt19937& gen) {
+    const int p = instancia.num_zonas;
+    const int N = instancia.N_filas;
+    const int M = instancia.M_columnas;
+    const std::size_t num_celdas = static_cast<std::size_t>(N) * M;
+
+    Solucion hijo(N, M);
+    Grid<zona_t>& zonas = hijo.zonas_asignadas;
+    const Grid<zona_t>& zonas_a = a.zonas_asignadas;
+    const Grid<zona_t>& zonas_b = b.zonas_asignadas;
+    if (p < 2) {
+        zonas = zonas_a;
+        hijo.costo = evaluar_solucion(instancia, hijo, umbral_varianza);
+        return hijo;
+    }
+
+    // Zonas que aporta a: cada una con probabilidad 1/2, al menos una y nunca todas
+    std::vector<char> de_a(p, 0);
+    int tomadas = 0;
+    std::bernoulli_distribution moneda(0.5);
+    for (int k = 0; k < p; ++k) {
+        de_a[k] = moneda(gen);
+        tomadas += de_a[k];
+    }
+    std::uniform_int_distribution<int> zona_al_azar(0, p - 1);
+    if (tomadas == 0) de_a[zona_al_azar(gen)] = 1;
+    if (tomadas == p) de_a[zona_al_azar(gen)] = 0;
+
+    std::vector<long long> cubre(p, 0);
+    for (std::size_t idx = 0; idx < num_celdas; ++idx) {
+        if (de_a[zonas_a[idx]]) {
+            zonas[idx] = zonas_a[idx];
+        } else {
+            zonas[idx] = SIN_ZONA;
+            ++cubre[zonas_b[idx]];
+        }
+    }
+
+    // Las zonas de b que más celdas libres cubren se quedan con las etiquetas libres
+    std::vector<int> orden(p);
+    std::iota(orden.begin(), orden.end(), 0);
+    std::stable_sort(orden.begin(), orden.end(), [&](int x, int y) { return cubre[x] > cubre[y]; });
+    std::vector<zona_t> etiqueta_b(p, SIN_ZONA);
+    int libre = 0;
+    for (int zona_b : orden) {
+        while (libre < p && de_a[libre]) ++libre;
+        if (libre >= p || cubre[zona_b] == 0) break;
+        etiqueta_b[zona_b] = static_cast<zona_t>(libre++);
+    }
+
+    std::vector<int> cola;
+    cola.reserve(num_celdas);
+    for (std::size_t idx = 0; idx < num_celdas; ++idx) {
+        if (zonas[idx] == SIN_ZONA) zonas[idx] = etiqueta_b[zonas_b[idx]];
+        if (zonas[idx] != SIN_ZONA) cola.push_back(static_cast<int>(idx));
+    }
+
+    // Reparación: las celdas sin etiqueta toman la de la celda asignada más cercana
+    int dr[] = {-1, 1, 0, 0};
+    int dc[] = {0, 0, -1, 1};
+    for (std::size_t cabeza = 0; cabeza < cola.size(); ++cabeza) {
+        int idx = cola[cabeza];
+        int i = idx / M, j = idx % M;
+        for (int d = 0; d < 4; ++d) {
+            int ni = i + dr[d], nj = j + dc[d];
+            if (ni < 0 || ni >= N || nj < 0 || nj >= M || zonas(ni, nj) != SIN_ZONA) continue;
+            zonas(ni, nj) = zonas[idx];
+            cola.push_back(ni * M + nj);
+        }
+    }
+
+    // Etiquetas sin celdas: se compactan y se recuperan dividiendo zonas
+    std::vector<long long> conteo(p, 0);
+    for (zona_t z : zonas) ++conteo[z];
+    std::vector<zona_t> compacta(p);
+    int usadas = 0;
+    for (int k = 0; k < p; ++k) {
+        if (conteo[k] > 0) compacta[k] = static_cast<zona_t>(usadas++);
+    }
+    if (usadas < p) {
+        for (zona_t& z : zonas) z = compacta[z];
+    }
+    ajustar_num_zonas(instancia, hijo, usadas, umbral_varianza);
+    return hijo;
+}
+
+Solucion resolver_poblacion(const Instancia& instancia, double umbral_varianza, const OpcionesBusqueda& opciones,
+                            EstadisticasEjecucion* estadisticas) {
+    using reloj = std::chrono::steady_clock;
+    auto segundos_desde = [](reloj::time_point t) { return std::chrono::duration<double>(reloj::now() - t).count(); };
+    auto inicio_busqueda = reloj::now();
+
+    const ParametrosPoblacion& parametros = opciones.parametros_poblacion;
+    const int num_subpoblaciones = parametros.subpoblaciones > 0 ? parametros.subpoblaciones
+                                                                 : std::max(1, opciones.num_hilos);
+
+    // Búsqueda local de cada individuo: los hilos que sobran van a BEST/TESELAS
+    OpcionesBusqueda opciones_locales = opciones;
+    opciones_locales.num_hilos = std::max(1, opciones.num_hilos / num_subpoblaciones);
+    opciones_locales.poblacion = false;
+    opciones_locales.solucion_inicial = nullptr;
+
+    Presupuesto presupuesto(opciones.limite_tiempo, opciones.max_evaluaciones, opciones.archivo_traza);
+    std::vector<Subpoblacion> subpoblaciones(num_subpoblaciones);
+    std::vector<BuzonMigracion> buzones(num_subpoblaciones);
+
+    auto worker = [&](int s) {
+        Subpoblacion& sp = subpoblaciones[s];
+        std::mt19937 gen = generador_para(opciones.semilla, s);
+        int busquedas = 0;
+
+        // Mejora `inicial` y registra la búsqueda como un "restart" de las estadísticas
+        auto buscar = [&](Solucion inicial, reloj::time_point t0) {
+            EstadisticasRestart registro;
+            if (opciones.conexo) reparar_conectividad(inicial, instancia.num_zonas);
+            if (estadisticas) {
+                registro.restart = busquedas * num_subpoblaciones + s;
+                registro.tiempo_inicial = segundos_desde(t0);
+                registro.costo_inicial = evaluar_solucion(instancia, inicial, umbral_varianza);
+                contadores_hilo() = ContadoresBusqueda();
+                t0 = reloj::now();
+            }
+            ++busquedas;
+            Solucion mejorada = mejorar_solucion(instancia, std::move(inicial), umbral_varianza, opciones_locales,
+                                                 gen, &presupuesto);
+            presupuesto.reportar_costo(mejorada.costo);
+            if (estadisticas) {
+                registro.tiempo_busqueda = segundos_desde(t0);
+                registro.costo_final = mejorada.costo;
+                registro.contadores = contadores_hilo();
+                sp.estadisticas.push_back(registro);
+            }
+            return mejorada;
+        };
+
+        for (int k = 0; k < parametros.tamano && !presupuesto.agotado(); ++k) {
+            auto t0 = reloj::now();
+            Solucion inicial = (s == 0 && k == 0 && opciones.solucion_inicial)
+                ? *opciones.solucion_inicial
+                : generar_solucion_inicial(instancia, gen, opciones.inicial);
+            sp.individuos.push_back(buscar(std::move(inicial), t0));
+        }
+
+        // Torneo binario: el mejor de dos individuos al azar
+        auto torneo = [&]() {
+            std::uniform_int_distribution<std::size_t> al_azar(0, sp.individuos.size() - 1);
+            std::size_t x = al_azar(gen), y = al_azar(gen);
+            return sp.individuos[y].costo < sp.individuos[x].costo ? y : x;
+        };
+
+        for (int g = 1; parametros.generaciones == 0 || g <= parametros.generaciones; ++g) {
+            if (presupuesto.agotado() || sp.individuos.size() < 2) break;
+
+            auto t0 = reloj::now();
+            std::size_t padre = torneo();
+            std::size_t madre = torneo();
+            if (madre == padre) madre = (padre + 1) % sp.individuos.size();
+            Solucion hijo = buscar(cruzar_regiones(instancia, sp.individuos[padre], sp.individuos[madre],
+                                                   umbral_varianza, gen), t0);
+            ++sp.hijos;
+            if (insertar(sp.individuos, hijo)) ++sp.hijos_aceptados;
+
+            if (num_subpoblaciones > 1 && g % parametros.intervalo_migracion == 0) {
+                buzones[(s + 1) % num_subpoblaciones].enviar(sp.individuos[indice_mejor(sp.individuos)]);
+                std::unique_ptr<Solucion> migrante = buzones[s].recibir();
+                if (migrante && insertar(sp.individuos, *migrante)) ++sp.migrantes_aceptados;
+            }
+        }
+    };
+
+    if (num_subpoblaciones == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> hilos;
+        for (int s = 0; s < num_subpoblaciones; ++s) hilos.emplace_back(worker, s);
+        for (auto& h : hilos) h.join();
+    }
+
+    // Mejor individuo global; ante empate, el de la subpoblación de menor índice
+    const Solucion* mejor = nullptr;
+    int hijos = 0, hijos_aceptados = 0, migrantes_aceptados = 0;
+    for (const Subpoblacion& sp : subpoblaciones) {
+        hijos += sp.hijos;
+        hijos_aceptados += sp.hijos_aceptados;
+        migrantes_aceptados += sp.migrantes_aceptados;
+        if (sp.individuos.empty()) continue;
+        const Solucion& candidato = sp.individuos[indice_mejor(sp.individuos)];
+        if (!mejor || candidato.costo < mejor->costo) mejor = &candidato;
+    }
+
+    if (opciones.reportar_mejoras) {
+        std::cout << "Poblacion: " << num_subpoblaciones << " subpoblaciones de " << parametros.tamano
+                  << " individuos, " << hijos << " hijos (" << hijos_aceptados << " aceptados), "
+                  << migrantes_aceptados << " migrantes aceptados" << std::endl;
+    }
+
+    if (estadisticas) {
+        estadisticas->restarts.clear();
+        for (const Subpoblacion& sp : subpoblaciones) {
+            estadisticas->restarts.insert(estadisticas->restarts.end(), sp.estadisticas.begin(), sp.estadisticas.end());
+        }
+        std::sort(estadisticas->restarts.begin(), estadisticas->restarts.end(),
+                  [](const EstadisticasRestart& x, const EstadisticasRestart& y) { return x.restart < y.restart; });
+        estadisticas->tiempo_busqueda = segundos_desde(inicio_busqueda);
+    }
+
+    if (!mejor) {
+        // El presupuesto se agotó antes del primer individuo: al menos uno, sin búsqueda local
+        std::mt19937 gen = generador_para(opciones.semilla, 0);
+        Solucion sol = opciones.solucion_inicial ? *opciones.solucion_inicial
+                                                 : generar_solucion_inicial(instancia, gen, opciones.inicial);
+        if (opciones.conexo) reparar_conectividad(sol, instancia.num_zonas);
+        sol.costo = evaluar_solucion(instancia, sol, umbral_varianza);
+        return sol;
+    }
+    return *mejor;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <random>
+#include "spp.hpp"
+
+/**
+ * @brief Cruce por regiones: el hijo hereda zonas completas de sus padres.
+ *
+ * Toma al azar cerca de la mitad de las zonas de `a` (al menos una, nunca
+ * todas) con sus etiquetas. En el resto del mapa copia las zonas de `b`,
+ * de la que más celdas libres cubre a la que menos, asignándoles las
+ * etiquetas que `a` no aportó; las celdas de zonas de `b` que no alcanzan
+ * etiqueta se rellenan por BFS desde las celdas ya asignadas. Si alguna
+ * etiqueta queda vacía se divide la zona de mayor varianza (ver barrido.hpp).
+ *
+ * Las zonas de `b` recortadas por las de `a` pueden quedar partidas o con
+ * islas; la búsqueda local posterior las repara. Deja `costo` evaluado.
+ */
+Solucion cruzar_regiones(const Instancia& instancia, const Solucion& a, const Solucion& b, double umbral_varianza,
+                         std::mt19937& gen);
+
+/**
+ * @brief Búsqueda poblacional en modelo de islas: reemplaza los restarts
+ * independientes de `resolver_con_restart`.
+ *
+ * Cada subpoblación (`parametros_poblacion.subpoblaciones`, una por hilo)
+ * parte de `tamano` soluciones iniciales mejoradas con `mejorar_solucion`. En
+ * cada generación elige dos padres por torneo binario, los cruza con
+ * `cruzar_regiones`, mejora al hijo con la búsqueda local de `opciones` y lo
+ * deja en lugar del peor individuo si lo supera y no repite un costo ya
+ * presente (para no perder diversidad).
+ *
+ * Cada `intervalo_migracion` generaciones, una copia del mejor individuo se
+ * deja en el buzón de la subpoblación siguiente (anillo), y el que haya en
+ * el buzón propio entra como un hijo más. El buzón es un puntero atómico:
+ * enviar y recibir son un `exchange`, sin locks ni esperas, y quien saca el
+ * puntero es su dueño. Si nadie leyó el migrante anterior, el nuevo lo
+ * reemplaza.
+ *
+ * Con una subpoblación el resultado depende solo de `opciones.semilla`; con
+ * varias, también del momento en que llega cada migrante. Respeta el
+ * presupuesto (tiempo/evaluaciones) igual que los restarts. Con
+ * `opciones.solucion_inicial`, el primer individuo de la subpoblación 0
+ * parte de ella.
+ */
+Solucion resolver_poblacion(const Instancia& instancia, double umbral_varianza, const OpcionesBusqueda& opciones,
+                            EstadisticasEjecucion* estadisticas = nullptr);
@@ -0,0 +1,60 @@
+#include "presupuesto.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+#include "spp.hpp"
+
+namespace {
+
+// Ignora "mejoras" que son solo ruido de redondeo del costo incremental
+bool mejora(double costo, double mejor) {
+    if (std::isinf(mejor)) return costo < mejor;
+    return costo < mejor - EPSILON_MEJORA * std::max(1.0, std::fabs(mejor));
+}
+
+} // namespace
+
+Presupuesto::Presupuesto(double limite_segundos, long long max_evaluaciones, const std::string& archivo_traza)
+    : inicio(std::chrono::steady_clock::now()),
+      limite_segundos(limite_segundos),
+      max_evaluaciones(max_evaluaciones),
+      mejor_costo(std::numeric_limits<double>::infinity()) {
+
+    if (!archivo_traza.empty()) {
+        traza.open(archivo_traza);
+        if (!traza.is_open()) {
+            throw std::runtime_error("No se pudo escribir el archivo: " + archivo_traza);
+        }
+        traza << std::setprecision(10) << "Tiempo,Evaluaciones,Mejor_Costo\n";
+    }
+}
+
+double Presupuesto::segundos() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+bool Presupuesto::consumir(long long n) {
+    long long total = evaluaciones_totales.fetch_add(n, std::memory_order_relaxed) + n;
+
+    bool agotado_ahora = (max_evaluaciones > 0 && total >= max_evaluaciones) ||
+                         (limite_segundos > 0.0 && segundos() >= limite_segundos);
+    if (agotado_ahora) detenido.store(true, std::memory_order_relaxed);
+    return agotado_ahora || agotado();
+}
+
+void Presupuesto::reportar_costo(double costo) {
+    // Camino rápido sin lock: casi siempre no hay mejora global
+    if (!mejora(costo, mejor_costo.load(std::memory_order_relaxed))) return;
+
+    std::lock_guard<std::mutex> lock(mutex_traza);
+    if (!mejora(costo, mejor_costo.load(std::memory_order_relaxed))) return;
+    mejor_costo.store(costo, std::memory_order_relaxed);
+
+    if (traza.is_open()) {
+        traza << segundos() << "," << evaluaciones() << "," << costo << "\n";
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+/**
+ * @class Presupuesto
+ * @brief Límites de tiempo y de evaluaciones de una búsqueda, compartidos
+ * entre todos los hilos, más la traza de convergencia.
+ *
+ * Una "evaluación" es un vecino puntuado (un delta de `EstadoEvaluacion` o
+ * una entrada del kernel por lotes). Para no tocar el contador atómico en
+ * cada vecino, las búsquedas acumulan localmente y llaman a `consumir` cada
+ * `LOTE_EVALUACIONES`; por eso `--max-evals` puede pasarse en a lo más un
+ * lote por hilo.
+ *
+ * Si hay `archivo_traza`, cada vez que mejora el mejor costo global se
+ * escribe una fila `Tiempo,Evaluaciones,Mejor_Costo` (CSV).
+ */
+class Presupuesto {
+public:
+    static constexpr long long LOTE_EVALUACIONES = 256;
+
+    /**
+     * @param limite_segundos Tiempo máximo desde la construcción (0 = sin límite).
+     * @param max_evaluaciones Evaluaciones máximas (0 = sin límite).
+     * @param archivo_traza Ruta del CSV de convergencia ("" = sin traza).
+     */
+    Presupuesto(double limite_segundos, long long max_evaluaciones, const std::string& archivo_traza);
+
+    /**
+     * @brief Suma `n` evaluaciones. Devuelve true si el presupuesto se agotó
+     * (en ese caso la búsqueda debe terminar y devolver lo que tiene).
+     */
+    bool consumir(long long n);
+
+    /**
+     * @brief true si ya se agotó el tiempo o las evaluaciones.
+     */
+    bool agotado() const { return detenido.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Da el presupuesto por agotado: las búsquedas de todos los hilos
+     * se cortan en su próximo `consumir` (ej. porque otro hilo falló).
+     */
+    void detener() { detenido.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief Informa el costo de una solución alcanzada; si mejora el mejor
+     * global se registra en la traza.
+     */
+    void reportar_costo(double costo);
+
+    double segundos() const;
+    long long evaluaciones() const { return evaluaciones_totales.load(std::memory_order_relaxed); }
+
+private:
+    std::chrono::steady_clock::time_point inicio;
+    double limite_segundos;
+    long long max_evaluaciones;
+
+    std::atomic<long long> evaluaciones_totales{0};
+    std::atomic<bool> detenido{false};
+    std::atomic<double> mejor_costo;
+
+    std::mutex mutex_traza;
+    std::ofstream traza;
+};
@@ -0,0 +1,584 @@
+#include <iostream>
+#include <vector>
+#include <cmath>      // Para sqrt y pow
+#include <stdexcept>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <chrono>
+
+#include "spp.hpp"
+#include "evaluacion_incremental.hpp"
+#include "frontera.hpp"
+#include "busqueda_lote.hpp"
+#include "presupuesto.hpp"
+#include "estadisticas.hpp"
+#include "inicializacion.hpp"
+#include "conectividad.hpp"
+#include "multinivel.hpp"
+#include "poblacion.hpp"
+#include "motores.hpp"
+#include "varianza.hpp"
+
+// --------------------------------------------------------------------------
+// MOTOR DE NÚMEROS ALEATORIOS (Para 'Restart')
+// --------------------------------------------------------------------------
+
+/**
+ * @brief Genera un entero aleatorio en el rango [min, max]
+ */
+int randint(std::mt19937& gen, int min, int max) {
+    std::uniform_int_distribution<> dis(min, max);
+    return dis(gen);
+}
+
+/**
+ * @brief Crea el generador del restart `indice` a partir de la semilla maestra.
+ *
+ * Cada restart tiene su propio flujo, que depende solo de (semilla, indice):
+ * así el resultado no cambia con el número de hilos ni con el orden en que
+ * los workers toman los restarts.
+ */
+std::mt19937 generador_para(std::uint64_t semilla, std::uint64_t indice) {
+    std::seed_seq seq{static_cast<std::uint32_t>(semilla), static_cast<std::uint32_t>(semilla >> 32),
+                      static_cast<std::uint32_t>(indice), static_cast<std::uint32_t>(indice >> 32)};
+    return std::mt19937(seq);
+}
+
+/**
+ * @brief Semilla maestra de la sub-tarea `indice` (ej. cada ejecución de un batch).
+ */
+std::uint64_t derivar_semilla(std::uint64_t semilla, std::uint64_t indice) {
+    std::mt19937 gen = generador_para(semilla, indice);
+    std::uint64_t alto = gen();
+    return (alto << 32) | gen();
+}
+
+// 0. Instancias multibanda
+
+Instancia::Instancia(std::vector<Grid<float>> bandas, std::vector<double> pesos_banda, int p)
+    : Instancia(bandas.empty() ? Grid<float>() : std::move(bandas[0]), p) {
+    if (bandas.empty() || static_cast<int>(bandas.size()) > MAX_BANDAS) {
+        throw std::runtime_error("Una instancia debe tener entre 1 y " + std::to_string(MAX_BANDAS) + " bandas");
+    }
+    if (pesos_banda.size() != bandas.size()) {
+        throw std::runtime_error("Se esperaban " + std::to_string(bandas.size()) + " pesos (uno por banda), no " +
+                                 std::to_string(pesos_banda.size()));
+    }
+    for (double w : pesos_banda) {
+        if (!(w >= 0.0)) throw std::runtime_error("Los pesos de las bandas deben ser no negativos");
+    }
+    for (std::size_t b = 1; b < bandas.size(); ++b) {
+        if (bandas[b].filas() != N_filas || bandas[b].columnas() != M_columnas) {
+            throw std::runtime_error("La banda " + std::to_string(b) + " mide " + std::to_string(bandas[b].filas()) +
+                                     "x" + std::to_string(bandas[b].columnas()) + "; se esperaba " +
+                                     std::to_string(N_filas) + "x" + std::to_string(M_columnas));
+        }
+        bandas_extra.push_back(std::move(bandas[b]));
+    }
+    pesos = std::move(pesos_banda);
+}
+
+// 1. Generación de Solución Inicial (Greedy Espacial o Aleatoria)
+
+/**
+ * @brief Genera una solución inicial aleatoria.
+ *
+ * Asigna cada celda (i, j) del terreno a una zona aleatoria (0 a p-1).
+ * Esto sirve como punto de partida para el Hill Climbing y es esencial
+ * para la estrategia de "Restart", ya que cada "Restart" comienza
+ * desde un punto aleatorio diferente.
+ *
+ * @param instancia Los datos del problema.
+ * @param gen Generador del restart.
+ * @return Una 'Solucion' inicializada aleatoriamente.
+ */
+Solucion generar_solucion_inicial_aleatoria(const Instancia& instancia, std::mt19937& gen) {
+    Solucion sol(instancia.N_filas, instancia.M_columnas);
+
+    std::vector<Punto> semillas = elegir_semillas_uniformes(instancia, gen);
+
+    // Ahora la asignacion greedy espacial. Comparamos distancias al cuadrado
+    // en enteros: misma semilla ganadora que con sqrt, sin funciones trascendentes
+    for (int i = 0; i < instancia.N_filas; ++i) {
+        zona_t* fila = sol.zonas_asignadas.fila(i);
+        for (int j = 0; j < instancia.M_columnas; ++j) {
+            int zona_mas_cercana = 0;
+            long long distancia_minima = std::numeric_limits<long long>::max();
+            for (int k = 0; k < instancia.num_zonas; ++k) {
+                long long dr = i - semillas[k].r;
+                long long dc = j - semillas[k].c;
+                long long distancia = dr * dr + dc * dc;
+                if (distancia < distancia_minima) {
+                    distancia_minima = distancia;
+                    zona_mas_cercana = k;
+                }
+            }
+            fila[j] = static_cast<zona_t>(zona_mas_cercana);
+        }
+    }
+    // El costo se calculará por separado
+    return sol;
+}
+
+// 2. Cálculo de Función de Evaluación
+
+/**
+ * @brief Función auxiliar para calcular la varianza de un conjunto de datos.
+ *
+ * Varianza = (1/N) * Sum( (x_i - media)^2 )
+ *
+ * @param valores Vector de valores de una zona.
+ * @return La varianza (double) de los valores.
+ */
+double calcular_varianza(const std::vector<float>& valores) {
+    return momentos(valores.data(), valores.size()).varianza();
+}
+
+/**
+ * @brief Calcula la varianza total de todos los datos en la instancia,
+ * directo sobre el buffer de la Grid (sin copiarlo). Con varias bandas, la
+ * suma ponderada de la varianza de cada banda.
+ */
+double calcular_varianza_total(const Instancia& instancia){
+    double total = 0.0;
+    for (int b = 0; b < instancia.num_bandas(); ++b) {
+        const Grid<float>& datos = instancia.banda(b);
+        total += instancia.pesos[b] * momentos(datos.data(), datos.size()).varianza();
+    }
+    return total;
+}
+
+/**
+ * @brief Calcula la función de evaluación (costo) de una solución.
+ *
+ * Según lo investigado en el estado del arte, el objetivo del problema es
+ * minimizar la pérdida de representatividad de las zonas definidas.
+ * Lo que efectivamente se traduce a minimizar la suma de las varianzas internas
+ * de cada zona.
+ *
+ * Las varianzas por zona salen de `momentos_por_zona`, en una pasada sobre la
+ * grilla (una por banda); `evaluar_solucion_referencia` (varianza.hpp) es la
+ * versión original. Con varias bandas, la varianza de cada zona es la suma
+ * ponderada de sus varianzas por banda.
+ *
+ * @param instancia Los datos del terreno (S).
+ * @param solucion La partición de zonas (Z).
+ * @return El costo total (Suma de Varianzas Internas) como un 'double'.
+ */
+double evaluar_solucion(const Instancia& instancia, const Solucion& solucion, double umbral_varianza) {
+    ++contadores_hilo().evaluaciones_completas;
+
+    // Un buffer por hilo: después de la primera llamada no se reserva memoria
+    thread_local std::vector<MomentosVarianza> por_zona;
+    thread_local std::vector<double> varianza_por_zona;
+    por_zona.resize(instancia.num_zonas);
+    varianza_por_zona.assign(instancia.num_zonas, 0.0);
+    for (int b = 0; b < instancia.num_bandas(); ++b) {
+        momentos_por_zona(instancia.banda(b), solucion.zonas_asignadas, instancia.num_zonas, por_zona.data());
+        for (int k = 0; k < instancia.num_zonas; ++k) {
+            varianza_por_zona[k] += instancia.pesos[b] * por_zona[k].varianza(); // Zona vacía -> 0
+        }
+    }
+
+    double costo_total = 0.0;
+    double penalizacion_homogeneidad = 0.0;
+
+    for (int k = 0; k < instancia.num_zonas; ++k) {
+        double varianza_zona = varianza_por_zona[k];
+        costo_total += varianza_zona;
+        if (varianza_zona > umbral_varianza) {
+            // Si no cumple el umbral, aplicamos una penalización grande
+            penalizacion_homogeneidad += (varianza_zona - umbral_varianza) * PENALIZACION_HOMOGENEIDAD;
+        }
+    }
+
+    // Detección de islas y su respectiva penalización
+
+    double penalizacion_islas = 0.0;
+
+    // Direcciones para vecinos: Arriba, Abajo, Izquierda, Derecha
+    int dr[] = {-1, 1, 0, 0};
+    int dc[] = {0, 0, -1, 1};
+
+    for (int i = 0; i < instancia.N_filas; ++i) {
+        for (int j = 0; j < instancia.M_columnas; ++j) {
+            
+            int mi_zona = solucion.zonas_asignadas(i, j);
+            bool tengo_vecino_igual = false;
+            int vecinos_validos = 0;
+
+            for(int d=0; d<4; ++d) {
+                int ni = i + dr[d];
+                int nj = j + dc[d];
+
+                // Verificar límites del mapa
+                if(ni >= 0 && ni < instancia.N_filas && nj >= 0 && nj < instancia.M_columnas) {
+                    vecinos_validos++;
+                    if(solucion.zonas_asignadas(ni, nj) == mi_zona) {
+                        tengo_vecino_igual = true;
+                        break; // Se encontro un vecino de la misma zona, NO es isla
+                    }
+                }
+            }
+
+            // Si tengo vecinos, pero NINGUNO es de mi zona -> SOY UNA ISLA
+            if (vecinos_validos > 0 && !tengo_vecino_igual) {
+                penalizacion_islas += M_ISLA;
+            }
+        }
+    }
+
+
+
+    // Como estamos minimizando los valores, la penalización se suma al costo total
+    return costo_total + penalizacion_homogeneidad + penalizacion_islas;
+}
+
+// Algoritmo Hill Climbing 
+
+/**
+ * @brief Implementa la búsqueda local Hill Climbing con estrategia "First Improvement".
+ *
+ * Explora el "vecindario" de la solución actual. El vecindario se define
+ * cambiando la asignación de ZONA de UNA celda (i, j) a la vez. Normalmente
+ * solo se consideran celdas de frontera y, para cada una, las zonas de sus
+ * 4-vecinos: mover una celda interior (o a una zona no adyacente) la deja
+ * como isla, lo que no compensa salvo que haya penalizaciones activas.
+ *
+ * "First Improvement": Tan pronto como encuentra un movimiento (un "vecino")
+ * que MEJORA (reduce) el costo, lo acepta. Las celdas pendientes se guardan
+ * en una cola de trabajo; al aceptar un movimiento se encolan la celda y sus
+ * vecinos de frontera y la búsqueda sigue donde iba, sin volver a (0, 0).
+ *
+ * Cuando la cola se vacía se hace una pasada completa sobre la frontera
+ * (las estadísticas de zona cambiaron desde que se revisó cada celda).
+ * Si la frontera ya no mejora pero la solución aún paga penalizaciones
+ * (islas o zonas sobre el umbral), se prueba una pasada sobre el vecindario
+ * completo (todas las celdas, todas las zonas) antes de terminar.
+ * Continúa hasta que no se puede encontrar ninguna mejora en una pasada
+ * completa (alcanza un óptimo local).
+ *
+ * Cada vecino se evalúa con el delta incremental de `EstadoEvaluacion`
+ * (solo las dos zonas involucradas y la 4-vecindad de la celda), en vez de
+ * recalcular `evaluar_solucion` sobre todo el mapa.
+ *
+ * @param instancia Los datos del problema.
+ * @param sol_inicial La solución desde la cual comenzar la búsqueda.
+ * @param verificar_delta Si es true, contrasta cada delta con `evaluar_solucion` (depuración).
+ * @param presupuesto Límites compartidos (opcional). Si se agotan, se corta la
+ * búsqueda y se devuelve la solución actual, que nunca es peor que la inicial.
+ * @param conexo Si es true, las zonas deben seguir 4-conexas: se descartan
+ * (antes de puntuarlas) las celdas cuya salida desconecta su zona, y no se
+ * hace la pasada sobre el vecindario completo. `sol_actual` debe ser conexa.
+ * @return La `Solucion` optimizada (óptimo local, o la mejor alcanzada si se cortó).
+ */
+Solucion hill_climbing_first_improvement(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                                         bool verificar_delta, Presupuesto* presupuesto, bool conexo) {
+
+    EstadoEvaluacion estado(instancia, sol_actual, umbral_varianza, verificar_delta);
+    FronteraZonas frontera(sol_actual.zonas_asignadas);
+    std::optional<ConectividadZonas> conectividad;
+    if (conexo) conectividad.emplace(instancia.N_filas, instancia.M_columnas);
+
+    const int N = instancia.N_filas;
+    const int M = instancia.M_columnas;
+    std::deque<int> pendientes;
+    std::vector<char> en_cola(sol_actual.zonas_asignadas.size(), 0);
+
+    auto encolar = [&](int indice) {
+        if (!en_cola[indice] && frontera.contiene(indice)) {
+            en_cola[indice] = 1;
+            pendientes.push_back(indice);
+        }
+    };
+
+    // Aplica el movimiento y encola la celda y su 4-vecindad
+    auto aceptar = [&](int i, int j, int nueva_zona) {
+        estado.aplicar_movimiento(i, j, nueva_zona);
+        frontera.actualizar_alrededor(i, j);
+
+        int indice = i * M + j;
+        encolar(indice);
+        if (i > 0) encolar(indice - M);
+        if (i + 1 < N) encolar(indice + M);
+        if (j > 0) encolar(indice - 1);
+        if (j + 1 < M) encolar(indice + 1);
+    };
+
+    // Cuenta un movimiento probado; cada LOTE_EVALUACIONES los pasa al
+    // presupuesto compartido y devuelve true si hay que detenerse
+    long long evaluaciones_locales = 0;
+    bool detenido = false;
+    auto contar_evaluacion = [&]() {
+        ++estado.contadores().movimientos_probados;
+        if (!presupuesto || ++evaluaciones_locales < Presupuesto::LOTE_EVALUACIONES) return false;
+        detenido = presupuesto->consumir(evaluaciones_locales);
+        evaluaciones_locales = 0;
+        presupuesto->reportar_costo(estado.costo());
+        return detenido;
+    };
+
+    bool mejora_encontrada = true;
+    while (!detenido) {
+        if (pendientes.empty()) {
+            if (mejora_encontrada) {
+                mejora_encontrada = false;
+                ++estado.contadores().pasadas;
+                for (int indice : frontera.celdas()) encolar(indice);
+                continue;
+            }
+            if (!estado.penalizada()) break; // Pasada completa sin mejoras -> óptimo local
+            if (conexo) break; // Con zonas conexas solo se puede pasar a una zona vecina: ya se probó todo
+
+            // Vecindario completo: cualquier celda a cualquier otra zona
+            ++estado.contadores().pasadas;
+            for (int i = 0; i < N && !detenido; ++i) {
+                for (int j = 0; j < M && !detenido; ++j) {
+                    int zona_original = sol_actual.zonas_asignadas(i, j);
+                    for (int nueva_zona = 0; nueva_zona < instancia.num_zonas && !detenido; ++nueva_zona) {
+                        if (nueva_zona == zona_original) continue;
+                        double delta = estado.delta_movimiento(i, j, nueva_zona);
+                        contar_evaluacion();
+                        if (delta < -EPSILON_MEJORA) {
+                            aceptar(i, j, nueva_zona);
+                            mejora_encontrada = true;
+                            break;
+                        }
+                    }
+                }
+            }
+            if (!mejora_encontrada) break;
+            continue;
+        }
+
+        int indice = pendientes.front();
+        pendientes.pop_front();
+        en_cola[indice] = 0;
+
+        int i = indice / M;
+        int j = indice % M;
+
+        // Si sacarla desconecta su zona, ningún movimiento de esta celda es válido
+        if (conexo && !conectividad->puede_salir(sol_actual.zonas_asignadas, i, j)) {
+            ++estado.contadores().rechazos_conectividad;
+            continue;
+        }
+
+        // Probamos mover esta celda (i, j) a cada zona vecina
+        zona_t candidatas[4];
+        int num_candidatas = FronteraZonas::zonas_vecinas(sol_actual.zonas_asignadas, i, j, candidatas);
+
+        for (int c = 0; c < num_candidatas; ++c) {
+            double delta = estado.delta_movimiento(i, j, candidatas[c]);
+            contar_evaluacion();
+
+            // Este es el First 'Improvement' -> si mejora, aceptamos y seguimos con la cola
+            if (delta < -EPSILON_MEJORA) {
+                aceptar(i, j, candidatas[c]);
+                mejora_encontrada = true;
+                break;
+            }
+            if (detenido) break;
+        }
+    }
+    if (presupuesto) presupuesto->consumir(evaluaciones_locales);
+    contadores_hilo().sumar(estado.contadores());
+
+    // Costo final exacto, con la misma función que reportamos al usuario
+    sol_actual.costo = evaluar_solucion(instancia, sol_actual, umbral_varianza);
+    return sol_actual;
+}
+
+
+// Implementacion del Restart en First improvement
+
+/**
+ * @brief Resuelve el problema usando Hill Climbing con Múltiples Restarts.
+ *
+ * Ejecuta el algoritmo `hill_climbing_first_improvement` un número
+ * determinado de veces (`opciones.num_restarts`), cada vez comenzando desde
+ * una solución inicial aleatoria diferente.
+ *
+ * Los restarts se reparten entre `opciones.num_hilos` workers. Cada worker
+ * toma el siguiente restart libre de un contador atómico y guarda su propio
+ * mejor local, sin compartir locks; al final se reduce al mejor global
+ * (menor costo, y ante empate el restart de menor índice). Como cada restart
+ * usa su propio generador derivado de la semilla, el resultado para una
+ * semilla dada es el mismo con cualquier número de hilos.
+ *
+ * Con `EstrategiaBusqueda::BEST_IMPROVEMENT` o `TESELAS` los restarts se
+ * ejecutan en serie y los hilos se dedican a puntuar vecinos (o a procesar
+ * teselas) dentro de cada descenso.
+ * Con `opciones.motor` SA o TABU, cada restart sigue desde su óptimo local
+ * con recocido simulado o búsqueda tabú (ver `mejorar_solucion`).
+ *
+ * Con `opciones.limite_tiempo` o `opciones.max_evaluaciones` la búsqueda es
+ * "anytime": los descensos en curso se cortan al agotarse el presupuesto y
+ * se devuelve la mejor solución hasta ese momento. Si además
+ * `num_restarts <= 0`, se reinicia sin tope hasta agotar el presupuesto.
+ * (Con límite de tiempo, o con evaluaciones repartidas entre varios hilos,
+ * el resultado ya no es exactamente reproducible.)
+ *
+ * Guarda y devuelve la MEJOR solución encontrada en todas las ejecuciones.
+ *
+ * @param instancia Los datos del problema.
+ * @param umbral_varianza Umbral de homogeneidad (alpha * Var(S)).
+ * @param opciones Restarts, hilos, semilla, presupuesto y modo de verificación.
+ * Con `opciones.multinivel` los restarts se hacen sobre una versión
+ * agregada del mapa (ver `resolver_multinivel`). Con
+ * `opciones.solucion_inicial` el restart 0 arranca en caliente desde ella.
+ * Con `opciones.poblacion` los restarts se reemplazan por la búsqueda
+ * poblacional en modelo de islas (ver `resolver_poblacion`).
+ *
+ * @param estadisticas Si no es nullptr, se llena con tiempos, costos y
+ * contadores por restart (el costo inicial cuesta una evaluación completa extra).
+ * @return La mejor `Solucion` encontrada globalmente.
+ */
+Solucion resolver_con_restart(const Instancia& instancia, double umbral_varianza, const OpcionesBusqueda& opciones,
+                              EstadisticasEjecucion* estadisticas) {
+
+    if (opciones.multinivel) return resolver_multinivel(instancia, umbral_varianza, opciones, estadisticas);
+    if (opciones.poblacion) return resolver_poblacion(instancia, umbral_varianza, opciones, estadisticas);
+
+    using reloj = std::chrono::steady_clock;
+    auto segundos_desde = [](reloj::time_point t) { return std::chrono::duration<double>(reloj::now() - t).count(); };
+
+    struct MejorLocal {
+        Solucion solucion;
+        int restart;
+        std::vector<std::pair<int, double>> costo_por_restart;
+        std::vector<EstadisticasRestart> estadisticas;
+    };
+    auto inicio_busqueda = reloj::now();
+
+    Presupuesto presupuesto(opciones.limite_tiempo, opciones.max_evaluaciones, opciones.archivo_traza);
+
+    // Sin --restarts y con presupuesto, se reinicia hasta agotarlo
+    int num_restarts = opciones.num_restarts > 0 ? opciones.num_restarts : std::numeric_limits<int>::max();
+    bool hilos_internos = (opciones.estrategia != EstrategiaBusqueda::FIRST_IMPROVEMENT);
+    int num_hilos = hilos_internos ? 1 : std::max(1, std::min(opciones.num_hilos, num_restarts));
+
+    std::vector<MejorLocal> mejores(num_hilos, MejorLocal{Solucion(instancia.N_filas, instancia.M_columnas), -1, {}, {}});
+    std::atomic<int> siguiente_restart{0};
+
+    // Una excepción no puede salir de un std::thread (terminaría el proceso):
+    // cada hilo guarda la suya, corta a los demás y se relanza tras los join
+    std::vector<std::exception_ptr> errores(num_hilos);
+
+    auto restarts_del_hilo = [&](int id_hilo) {
+        MejorLocal& mejor = mejores[id_hilo];
+        while (!presupuesto.agotado()) {
+            int r = siguiente_restart++;
+            if (r >= num_restarts || r < 0) break;
+            std::mt19937 gen = generador_para(opciones.semilla, r);
+            EstadisticasRestart registro;
+            reloj::time_point t0;
+            if (estadisticas) {
+                contadores_hilo() = ContadoresBusqueda();
+                t0 = reloj::now();
+            }
+
+            // Generamos una solución inicial (greedy, Voronoi o crecimiento de regiones),
+            // salvo en el restart 0 si se parte de una zonificación cargada
+            Solucion sol_inicial = (r == 0 && opciones.solucion_inicial)
+                ? *opciones.solucion_inicial
+                : generar_solucion_inicial(instancia, gen, opciones.inicial);
+            if (opciones.conexo) reparar_conectividad(sol_inicial, instancia.num_zonas);
+
+            if (estadisticas) {
+                registro.restart = r;
+                registro.tiempo_inicial = segundos_desde(t0);
+                registro.costo_inicial = evaluar_solucion(instancia, sol_inicial, umbral_varianza);
+                t0 = reloj::now();
+            }
+
+            // Mejoramos dicha solucion con Hill Climbing (y el recocido o tabú, si se pidió)
+            Solucion sol_optimo_local = mejorar_solucion(instancia, std::move(sol_inicial), umbral_varianza,
+                                                         opciones, gen, &presupuesto);
+            if (opciones.conexo && opciones.verificar_delta &&
+                !zonas_conexas(sol_optimo_local.zonas_asignadas, instancia.num_zonas)) {
+                throw std::runtime_error("Restart " + std::to_string(r) + ": la busqueda desconecto una zona");
+            }
+            presupuesto.reportar_costo(sol_optimo_local.costo);
+            mejor.costo_por_restart.emplace_back(r, sol_optimo_local.costo);
+            if (estadisticas) {
+                registro.tiempo_busqueda = segundos_desde(t0);
+                registro.costo_final = sol_optimo_local.costo;
+                registro.contadores = contadores_hilo();
+                mejor.estadisticas.push_back(registro);
+            }
+
+            if (sol_optimo_local.costo < mejor.solucion.costo ||
+                (sol_optimo_local.costo == mejor.solucion.costo && r < mejor.restart)) {
+                mejor.solucion = std::move(sol_optimo_local);
+                mejor.restart = r;
+            }
+        }
+    };
+
+    auto worker = [&](int id_hilo) {
+        try {
+            restarts_del_hilo(id_hilo);
+        } catch (...) {
+            errores[id_hilo] = std::current_exception();
+            presupuesto.detener();
+        }
+    };
+
+    if (num_hilos == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> hilos;
+        for (int t = 0; t < num_hilos; ++t) hilos.emplace_back(worker, t);
+        for (auto& h : hilos) h.join();
+    }
+    for (const std::exception_ptr& error : errores) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Reportamos las mejoras en orden de restart, igual que la versión secuencial
+    std::vector<std::pair<int, double>> costo_por_restart;
+    for (const auto& m : mejores) {
+        costo_por_restart.insert(costo_por_restart.end(), m.costo_por_restart.begin(), m.costo_por_restart.end());
+    }
+    std::sort(costo_por_restart.begin(), costo_por_restart.end());
+
+    double mejor_costo = std::numeric_limits<double>::infinity();
+    for (std::size_t k = 0; k < costo_por_restart.size() && opciones.reportar_mejoras; ++k) {
+        // std::cout << "  Restart " << (costo_por_restart[k].first + 1)
+        //           << " -> Costo (Con Penalización) " << costo_por_restart[k].second << std::endl;
+        if (costo_por_restart[k].second < mejor_costo) {
+            mejor_costo = costo_por_restart[k].second;
+            std::cout << "  --> Nueva mejor solucion encontrada! " << std::endl;
+        }
+    }
+    if (opciones.reportar_mejoras && (opciones.limite_tiempo > 0.0 || opciones.max_evaluaciones > 0)) {
+        std::cout << "Restarts ejecutados: " << costo_por_restart.size()
+                  << " (" << presupuesto.evaluaciones() << " evaluaciones)" << std::endl;
+    }
+
+    if (estadisticas) {
+        estadisticas->restarts.clear();
+        for (const auto& m : mejores) {
+            estadisticas->restarts.insert(estadisticas->restarts.end(), m.estadisticas.begin(), m.estadisticas.end());
+        }
+        std::sort(estadisticas->restarts.begin(), estadisticas->restarts.end(),
+                  [](const EstadisticasRestart& a, const EstadisticasRestart& b) { return a.restart < b.restart; });
+        estadisticas->tiempo_busqueda = segundos_desde(inicio_busqueda);
+    }
+
+    MejorLocal* mejor_global = &mejores[0];
+    for (auto& m : mejores) {
+        if (m.restart < 0) continue;
+        if (mejor_global->restart < 0 || m.solucion.costo < mejor_global->solucion.costo ||
+            (m.solucion.costo == mejor_global->solucion.costo && m.restart < mejor_global->restart)) {
+            mejor_global = &m;
+        }
+    }
+    return std::move(mejor_global->solucion);
+}
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <vector>
+#include <random>     // Para generación de números aleatorios (proceso estocástico)
+#include <limits>     // Para std::numeric_limits
+#include <string>
+#include <utility>
+#include <cstdint>
+
+#include "grid.hpp"
+
+// --------------------------------------------------------------------------
+// CONSTANTES DE LA FUNCIÓN OBJETIVO
+// --------------------------------------------------------------------------
+
+// Factor de penalización muuuuy grande por violar el umbral de homogeneidad
+constexpr double PENALIZACION_HOMOGENEIDAD = 1e9;
+
+// El castigo por ser isla debe ser lo suficientemente alto para motivar el cambio,
+// pero idealmente menor que violar la homogeneidad global.
+constexpr double M_ISLA = 5000.0;
+
+// Un movimiento solo se acepta si baja el costo más que este margen; evita
+// ciclar por ruido de redondeo en los deltas incrementales.
+constexpr double EPSILON_MEJORA = 1e-9;
+
+// Bandas (índices por celda) como máximo en una instancia multibanda
+constexpr int MAX_BANDAS = 16;
+
+// --------------------------------------------------------------------------
+// ESTRUCTURAS DE DATOS PRINCIPALES
+// --------------------------------------------------------------------------
+
+/**
+ * @struct Instancia cualquiera, para el comienzo del algoritmo se puede definir la instancia inicial y luego esta se va modificando mediante avance el algoritmo.
+ * @brief Almacena los datos de entrada del problema.
+ *
+ * @var datos_terreno Matriz (N x M) con los valores del índice (ej. NDVI, humedad).
+ * Es la banda 0: los módulos de una sola banda solo miran esta.
+ * @var bandas_extra Bandas 1..B-1 de una instancia multibanda (ej. humedad y
+ * temperatura junto al NDVI), cada una en su propio plano contiguo (SoA) de
+ * las mismas dimensiones que `datos_terreno`.
+ * @var pesos Peso de cada banda en el costo (B entradas).
+ * @var num_zonas (p) El número de sensores/zonas a definir.
+ *
+ * Con varias bandas, la varianza de una zona es la suma ponderada de sus
+ * varianzas por banda; con una banda y peso 1 es la de siempre.
+ */
+struct Instancia {
+    Grid<float> datos_terreno;
+    std::vector<Grid<float>> bandas_extra;
+    std::vector<double> pesos;
+    int num_zonas;
+    int N_filas;
+    int M_columnas;
+
+    Instancia(Grid<float> datos, int p)
+        : datos_terreno(std::move(datos)), pesos(1, 1.0), num_zonas(p) {
+        N_filas = datos_terreno.filas();
+        M_columnas = datos_terreno.columnas();
+    }
+
+    /**
+     * @brief Instancia multibanda: `bandas[0]` pasa a `datos_terreno` y el
+     * resto a `bandas_extra`. Lanza std::runtime_error si las dimensiones no
+     * coinciden, si hay más de MAX_BANDAS o si `pesos` no tiene una entrada
+     * no negativa por banda.
+     */
+    Instancia(std::vector<Grid<float>> bandas, std::vector<double> pesos, int p);
+
+    int num_bandas() const { return 1 + static_cast<int>(bandas_extra.size()); }
+    const Grid<float>& banda(int b) const { return b == 0 ? datos_terreno : bandas_extra[b - 1]; }
+};
+
+/**
+ * @struct Solucion
+ * @brief Representa una solución al problema.
+ *
+ * @var zonas_asignadas Matriz (N x M) donde cada celda (i, j) tiene un ID
+ * de zona (0 a p-1), guardado como `zona_t`.
+ * @var costo El valor de la función objetivo (costo) para esta solución.
+ * Usamos 'double' para precisión.
+ */
+struct Solucion {
+    Grid<zona_t> zonas_asignadas;
+    double costo;
+
+    Solucion(int N, int M) : zonas_asignadas(N, M, 0), costo(std::numeric_limits<double>::infinity()) {}
+};
+
+struct Punto {
+    int r,c;
+};
+
+// --------------------------------------------------------------------------
+// MOTOR DE NÚMEROS ALEATORIOS (Para 'Restart')
+// --------------------------------------------------------------------------
+int randint(std::mt19937& gen, int min, int max);
+std::mt19937 generador_para(std::uint64_t semilla, std::uint64_t indice);
+std::uint64_t derivar_semilla(std::uint64_t semilla, std::uint64_t indice);
+
+/**
+ * @brief Cómo se construye la solución inicial de cada restart.
+ *
+ * GREEDY: semillas uniformes y cada celda a la semilla más cercana (euclidiana).
+ * VORONOI: semillas uniformes y BFS multi-fuente (Manhattan), en O(N*M).
+ * CRECIMIENTO: semillas k-means++ sobre los valores y crecimiento de regiones por valor.
+ */
+enum class MetodoInicial {
+    GREEDY,
+    VORONOI,
+    CRECIMIENTO
+};
+
+/**
+ * @brief Estrategia de la búsqueda local.
+ *
+ * FIRST_IMPROVEMENT: acepta el primer vecino que mejora (secuencial).
+ * BEST_IMPROVEMENT: puntúa todos los vecinos en paralelo y aplica en lote
+ * los mejores (ver `busqueda_lote.hpp`).
+ * TESELAS: First Improvement de una sola solución repartido en teselas que
+ * procesan varios hilos a la vez (ver `teselas.hpp`).
+ */
+enum class EstrategiaBusqueda {
+    FIRST_IMPROVEMENT,
+    BEST_IMPROVEMENT,
+    TESELAS
+};
+
+/**
+ * @brief Motor de búsqueda de cada restart (ver motores.hpp).
+ *
+ * HC: solo el descenso de Hill Climbing (según `EstrategiaBusqueda`).
+ * SA: descenso y luego recocido simulado desde el óptimo local.
+ * TABU: descenso y luego búsqueda tabú desde el óptimo local.
+ */
+enum class MotorBusqueda {
+    HC,
+    SA,
+    TABU
+};
+
+/**
+ * @struct ParametrosRecocido
+ * @brief Esquema de enfriamiento del recocido simulado.
+ *
+ * @var temperatura_inicial T0 (0 = estimada de una muestra de vecinos).
+ * @var enfriamiento Factor geométrico por nivel de temperatura (0 < f < 1).
+ * @var pasos_por_temperatura Movimientos intentados por nivel (0 = tamaño de la frontera).
+ * @var temperatura_final_relativa Se termina cuando T < T0 * este valor.
+ */
+struct ParametrosRecocido {
+    double temperatura_inicial = 0.0;
+    double enfriamiento = 0.95;
+    int pasos_por_temperatura = 0;
+    double temperatura_final_relativa = 1e-3;
+};
+
+/**
+ * @struct ParametrosTabu
+ * @brief Parámetros de la búsqueda tabú.
+ *
+ * @var tenencia Iteraciones que una celda no puede volver a la zona que dejó.
+ * @var candidatos Celdas de frontera muestreadas por iteración.
+ * @var max_sin_mejora Iteraciones sin mejorar el mejor antes de parar (0 = automático).
+ */
+struct ParametrosTabu {
+    int tenencia = 50;
+    int candidatos = 8;
+    int max_sin_mejora = 0;
+};
+
+/**
+ * @struct ParametrosPoblacion
+ * @brief Parámetros de la búsqueda poblacional en modelo de islas (ver poblacion.hpp).
+ *
+ * @var subpoblaciones Subpoblaciones, cada una en su hilo (0 = `num_hilos`).
+ * @var tamano Individuos por subpoblación.
+ * @var generaciones Hijos por subpoblación (0 = hasta agotar el presupuesto).
+ * @var intervalo_migracion Generaciones entre envíos de la élite a la subpoblación vecina.
+ */
+struct ParametrosPoblacion {
+    int subpoblaciones = 0;
+    int tamano = 8;
+    int generaciones = 40;
+    int intervalo_migracion = 5;
+};
+
+/**
+ * @struct OpcionesBusqueda
+ * @brief Parámetros del driver de restarts.
+ *
+ * @var num_hilos Workers entre los que se reparten los restarts. Con
+ * BEST_IMPROVEMENT o TESELAS los restarts van en serie y los hilos se usan
+ * dentro de cada descenso.
+ * @var semilla Semilla maestra; cada restart deriva de ella su propio generador.
+ * @var verificar_delta Contrasta cada delta incremental con `evaluar_solucion` (depuración).
+ * @var reportar_mejoras Imprime "Nueva mejor solucion encontrada!" por cada mejora.
+ * @var inicial Método de solución inicial de cada restart.
+ * @var motor Hill Climbing, recocido simulado o búsqueda tabú; `recocido` y `tabu` son sus parámetros.
+ * @var conexo Restricción dura: cada zona debe ser 4-conexa (ver conectividad.hpp).
+ * @var multinivel Resuelve en una pirámide de bloques 2x2 y refina hacia abajo (ver multinivel.hpp).
+ * @var niveles Niveles de agregación con `multinivel` (0 = automático).
+ * @var lado_tesela Lado en celdas de las teselas con la estrategia TESELAS.
+ * @var poblacion Reemplaza los restarts independientes por subpoblaciones
+ * que se cruzan y migran su élite (ver poblacion.hpp); `parametros_poblacion`
+ * son sus parámetros.
+ * @var solucion_inicial Si no es nullptr, el restart 0 parte de esta
+ * zonificación (arranque en caliente, `--init-from`) en vez de generar una;
+ * los demás restarts generan la suya como siempre. No es dueño del puntero.
+ * @var usar_cache Lee/escribe la caché binaria `<instancia>.sppb` (ver `leer_datos`).
+ * @var limite_tiempo Segundos máximos de búsqueda (0 = sin límite).
+ * @var max_evaluaciones Vecinos evaluados como máximo (0 = sin límite).
+ * @var archivo_traza CSV de convergencia (tiempo, evaluaciones, mejor costo); "" = sin traza.
+ * @var archivo_estadisticas JSON con contadores y tiempos (ver estadisticas.hpp); "" = no se recolectan.
+ *
+ * Con un límite de tiempo o de evaluaciones la búsqueda se corta limpiamente
+ * y devuelve la mejor solución hasta ese momento.
+ */
+struct OpcionesBusqueda {
+    int num_restarts = 20;
+    int num_hilos = 1;
+    std::uint64_t semilla = 0;
+    bool verificar_delta = false;
+    EstrategiaBusqueda estrategia = EstrategiaBusqueda::FIRST_IMPROVEMENT;
+    bool reportar_mejoras = true;
+    MetodoInicial inicial = MetodoInicial::GREEDY;
+    MotorBusqueda motor = MotorBusqueda::HC;
+    ParametrosRecocido recocido;
+    ParametrosTabu tabu;
+    bool conexo = false;
+    bool multinivel = false;
+    int niveles = 0;
+    int lado_tesela = 64;
+    bool poblacion = false;
+    ParametrosPoblacion parametros_poblacion;
+    const Solucion* solucion_inicial = nullptr;
+    bool usar_cache = true;
+    double limite_tiempo = 0.0;
+    long long max_evaluaciones = 0;
+    std::string archivo_traza;
+    std::string archivo_estadisticas;
+};
+
+class Presupuesto;              // presupuesto.hpp
+struct EstadisticasEjecucion;   // estadisticas.hpp
+
+// --------------------------------------------------------------------------
+// ALGORITMO
+// --------------------------------------------------------------------------
+Solucion generar_solucion_inicial_aleatoria(const Instancia& instancia, std::mt19937& gen);
+
+double calcular_varianza(const std::vector<float>& valores);
+double calcular_varianza_total(const Instancia& instancia);
+double evaluar_solucion(const Instancia& instancia, const Solucion& solucion, double umbral_varianza);
+
+Solucion hill_climbing_first_improvement(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                                         bool verificar_delta = false, Presupuesto* presupuesto = nullptr,
+                                         bool conexo = false);
+Solucion resolver_con_restart(const Instancia& instancia, double umbral_varianza, const OpcionesBusqueda& opciones,
+                              EstadisticasEjecucion* estadisticas = nullptr);
+
+// --------------------------------------------------------------------------
+// LECTURA DE INSTANCIAS (lectura.cpp)
+// --------------------------------------------------------------------------
+// Lee un .spp (texto) o .sppb (binario). Con `usar_cache`, un .spp se
+// acompaña de una caché `<archivo>.sppb` que se mapea sin copiar.
+Grid<float> leer_datos(const std::string& filename, bool usar_cache = true);
+
+Grid<float> leer_spp_texto(const std::string& filename);     // mmap + std::from_chars
+Grid<float> leer_spp_ifstream(const std::string& filename);  // Lector original, de referencia
+Grid<float> leer_sppb(const std::string& filename);
+void escribir_sppb(const std::string& filename, const Grid<float>& datos);
+void escribir_spp(const std::string& ruta, const Grid<float>& datos);       // Texto, dos decimales
+
+// Píxeles por celda del mapa de calor; `factorHeatmap` lo reduce en mapas
+// grandes para que la imagen no pase de unos miles de píxeles de lado
+constexpr int FACTOR_HEATMAP = 30;
+int factorHeatmap(int filas, int columnas);
+
+// Muestra el mapa de calor (con zonas: bordes y una etiqueta por zona si `showLabels`)
+void plotHeatmap(const Grid<float>& M, int factor, const Grid<zona_t>& Z = Grid<zona_t>(), bool showLabels = false);
+
+// Igual que `plotHeatmap` pero lo guarda en `ruta` (formato según la
+// extensión, ej. .png) sin abrir ventanas; sirve sin display.
+void saveHeatmap(const std::string& ruta, const Grid<float>& M, int factor, const Grid<zona_t>& Z = Grid<zona_t>(),
+                 bool showLabels = false);
@@ -0,0 +1,340 @@
+#include "teselas.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "conectividad.hpp"
+#include "estadisticas.hpp"
+#include "evaluacion_incremental.hpp"
+#include "frontera.hpp"
+#include "presupuesto.hpp"
+
+namespace {
+
+// Con lados menores el halo de 2 celdas alcanzaría otra tesela del mismo color
+constexpr int LADO_TESELA_MINIMO = 4;
+
+struct Tesela {
+    int fila_ini, fila_fin;
+    int col_ini, col_fin;
+    int color;
+};
+
+/**
+ * @brief Lo que una tesela cambió en una fase: deltas por zona, islas, y
+ * (celda, zona anterior) de cada movimiento para poder deshacerla.
+ */
+struct CambiosTesela {
+    std::vector<long long> conteo;
+    std::vector<double> suma;
+    std::vector<double> cuadrados;
+    int islas = 0;
+    std::vector<std::pair<int, zona_t>> deshacer;
+    ContadoresBusqueda cuenta;
+
+    void reiniciar(int p) {
+        conteo.assign(p, 0);
+        suma.assign(p, 0.0);
+        cuadrados.assign(p, 0.0);
+        islas = 0;
+        deshacer.clear();
+        cuenta = ContadoresBusqueda();
+    }
+};
+
+/**
+ * @brief First Improvement sobre las celdas pendientes de una tesela, contra
+ * las estadísticas globales de `estado` más los cambios de la propia tesela.
+ * Escribe directo en `zonas`; `estado` no se modifica.
+ *
+ * Como la cola de `hill_climbing_first_improvement`, pero local: al mover
+ * una celda se encolan ella y sus 4 vecinos dentro de la tesela, y los
+ * vecinos del halo quedan marcados en `pendiente` para cuando les toque a
+ * sus teselas. Con `completo` prueba todas las zonas, no solo las vecinas
+ * (el vecindario completo cuando quedan penalizaciones).
+ */
+void procesar_tesela(const Tesela& tesela, const Instancia& instancia, const EstadoEvaluacion& estado,
+                     Grid<zona_t>& zonas, std::vector<char>& pendiente, bool conexo, bool completo,
+                     CambiosTesela& cambios, std::vector<int>& cola) {
+    const std::vector<long long>& conteo = estado.conteos();
+    const std::vector<double>& suma = estado.sumas();
+    const std::vector<double>& cuadrados = estado.sumas_cuadrados();
+    const int N = zonas.filas();
+    const int M = zonas.columnas();
+
+    auto costo_vista = [&](int z, long long dn, double ds, double dq) {
+        return estado.costo_de_zona(conteo[z] + cambios.conteo[z] + dn, suma[z] + cambios.suma[z] + ds,
+                                    cuadrados[z] + cambios.cuadrados[z] + dq);
+    };
+    auto dentro = [&](int i, int j) {
+        return i >= tesela.fila_ini && i < tesela.fila_fin && j >= tesela.col_ini && j < tesela.col_fin;
+    };
+
+    // `cola` es circular de a lo más una entrada por celda (las encoladas
+    // tienen `pendiente` = 2 hasta salir)
+    const std::size_t capacidad = static_cast<std::size_t>(tesela.fila_fin - tesela.fila_ini) *
+                                  (tesela.col_fin - tesela.col_ini);
+    cola.resize(capacidad);
+    std::size_t cabeza = 0;
+    std::size_t tamano = 0;
+    auto encolar = [&](int indice) {
+        cola[(cabeza + tamano) % capacidad] = indice;
+        ++tamano;
+        pendiente[indice] = 2;
+    };
+
+    for (int i = tesela.fila_ini; i < tesela.fila_fin; ++i) {
+        for (int j = tesela.col_ini; j < tesela.col_fin; ++j) {
+            if (pendiente[i * M + j]) encolar(i * M + j);
+        }
+    }
+    ++cambios.cuenta.pasadas;
+
+    while (tamano > 0) {
+        int indice = cola[cabeza];
+        cabeza = (cabeza + 1) % capacidad;
+        --tamano;
+        pendiente[indice] = 0;
+
+        int i = indice / M;
+        int j = indice % M;
+        if (!completo && !FronteraZonas::es_frontera(zonas, i, j)) continue;
+        if (conexo && !ConectividadZonas::puede_salir_local(zonas, i, j)) {
+            ++cambios.cuenta.rechazos_conectividad;
+            continue;
+        }
+
+        int a = zonas(i, j);
+        double x = instancia.datos_terreno(i, j);
+        double x2 = x * x;
+        double actual_a = costo_vista(a, 0, 0.0, 0.0);
+        double nuevo_a = costo_vista(a, -1, -x, -x2);
+
+        zona_t candidatas[4];
+        int num_candidatas = completo ? instancia.num_zonas : FronteraZonas::zonas_vecinas(zonas, i, j, candidatas);
+        for (int c = 0; c < num_candidatas; ++c) {
+            int b = completo ? c : candidatas[c];
+            if (b == a) continue;
+            int islas = estado.delta_islas(i, j, b);
+            double delta = (nuevo_a - actual_a) + (costo_vista(b, 1, x, x2) - costo_vista(b, 0, 0.0, 0.0)) +
+                           islas * M_ISLA;
+            ++cambios.cuenta.evaluaciones_delta;
+            ++cambios.cuenta.movimientos_probados;
+            if (delta < -EPSILON_MEJORA) {
+                cambios.deshacer.emplace_back(indice, static_cast<zona_t>(a));
+                zonas(i, j) = static_cast<zona_t>(b);
+                cambios.conteo[a] -= 1;
+                cambios.suma[a] -= x;
+                cambios.cuadrados[a] -= x2;
+                cambios.conteo[b] += 1;
+                cambios.suma[b] += x;
+                cambios.cuadrados[b] += x2;
+                cambios.islas += islas;
+
+                static const int DI[5] = {0, -1, 1, 0, 0};
+                static const int DJ[5] = {0, 0, 0, -1, 1};
+                for (int k = 0; k < 5; ++k) {
+                    int vi = i + DI[k];
+                    int vj = j + DJ[k];
+                    if (vi < 0 || vi >= N || vj < 0 || vj >= M) continue;
+                    int vecino = vi * M + vj;
+                    if (!dentro(vi, vj)) {
+                        pendiente[vecino] = 1;
+                    } else if (pendiente[vecino] != 2) {
+                        encolar(vecino);
+                    }
+                }
+                break;
+            }
+        }
+    }
+}
+
+void sumar_al_estado(EstadoEvaluacion& estado, const CambiosTesela& cambios, int signo) {
+    estado.sumar_cambios(cambios.conteo.data(), cambios.suma.data(), cambios.cuadrados.data(), cambios.islas,
+                         static_cast<long long>(cambios.deshacer.size()), signo);
+}
+
+} // namespace
+
+Solucion hill_climbing_teselas(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                               int num_hilos, int lado_tesela, bool verificar_delta, Presupuesto* presupuesto,
+                               bool conexo) {
+
+    // procesar_tesela puntúa con datos_terreno y una suma por zona (banda 0)
+    if (instancia.num_bandas() != 1) {
+        throw std::runtime_error("Las teselas solo admiten instancias de una banda");
+    }
+
+    // Los deltas de las teselas se calculan aparte: el estado solo acumula
+    EstadoEvaluacion estado(instancia, sol_actual, umbral_varianza, false);
+    Grid<zona_t>& zonas = sol_actual.zonas_asignadas;
+
+    const int N = instancia.N_filas;
+    const int M = instancia.M_columnas;
+    const int p = instancia.num_zonas;
+    lado_tesela = std::max(lado_tesela, LADO_TESELA_MINIMO);
+
+    const int filas_teselas = (N + lado_tesela - 1) / lado_tesela;
+    const int columnas_teselas = (M + lado_tesela - 1) / lado_tesela;
+    std::vector<Tesela> teselas;
+    teselas.reserve(static_cast<std::size_t>(filas_teselas) * columnas_teselas);
+    for (int ti = 0; ti < filas_teselas; ++ti) {
+        for (int tj = 0; tj < columnas_teselas; ++tj) {
+            teselas.push_back({ti * lado_tesela, std::min(N, (ti + 1) * lado_tesela),
+                               tj * lado_tesela, std::min(M, (tj + 1) * lado_tesela),
+                               (ti % 2) * 2 + (tj % 2)});
+        }
+    }
+    const int num_teselas = static_cast<int>(teselas.size());
+
+    std::vector<CambiosTesela> cambios(num_teselas);
+    std::vector<char> pendiente(zonas.size(), 1);
+    std::vector<char> activa(num_teselas, 1);
+    std::vector<char> cambio(num_teselas, 0);
+    bool todas_activas = true;
+    bool completo = false;
+    bool detenido = false;
+
+    // Con verificar_delta: el estado acumulado debe coincidir con evaluar_solucion
+    // cada vez que refleja todo lo escrito en `zonas`
+    auto verificar = [&](const std::string& momento) {
+        if (!verificar_delta) return;
+        double esperado = evaluar_solucion(instancia, sol_actual, umbral_varianza);
+        double obtenido = estado.costo();
+        if (std::fabs(esperado - obtenido) > 1e-6 * std::max(1.0, std::fabs(esperado))) {
+            throw std::runtime_error("Costo por teselas inconsistente " + momento + ": evaluar_solucion = " +
+                                     std::to_string(esperado) + ", incremental = " + std::to_string(obtenido));
+        }
+    };
+
+    // Teselas del color en serie: cada una ve los cambios de las anteriores
+    auto fase_serial = [&](const std::vector<int>& lista) {
+        std::vector<int> cola;
+        for (int t : lista) {
+            cambios[t].reiniciar(p);
+            procesar_tesela(teselas[t], instancia, estado, zonas, pendiente, conexo, completo, cambios[t], cola);
+            sumar_al_estado(estado, cambios[t], 1);
+            verificar("tras sumar la tesela " + std::to_string(t));
+        }
+    };
+
+    // Teselas del color en paralelo contra las estadísticas de inicio de fase;
+    // los cambios se suman al final, en orden de tesela. Con un solo hilo se
+    // hace igual, para que el resultado no dependa de `num_hilos`
+    auto fase_paralela = [&](const std::vector<int>& lista, int hilos_fase) {
+        std::atomic<int> siguiente{0};
+        auto worker = [&]() {
+            std::vector<int> cola;
+            for (int k = siguiente++; k < static_cast<int>(lista.size()); k = siguiente++) {
+                int t = lista[k];
+                cambios[t].reiniciar(p);
+                procesar_tesela(teselas[t], instancia, estado, zonas, pendiente, conexo, completo, cambios[t],
+                                cola);
+            }
+        };
+        if (hilos_fase <= 1) {
+            worker();
+        } else {
+            std::vector<std::thread> hilos;
+            for (int h = 0; h < hilos_fase; ++h) hilos.emplace_back(worker);
+            for (auto& h : hilos) h.join();
+        }
+
+        double antes = estado.costo();
+        for (int t : lista) sumar_al_estado(estado, cambios[t], 1);
+        // Las teselas ya escribieron todas en `zonas`: se verifica la suma completa
+        verificar("tras sumar las teselas de la fase");
+        if (estado.costo() <= antes + EPSILON_MEJORA * std::max(1.0, std::fabs(antes))) return;
+
+        // Cambios simultáneos sobre la misma zona empeoraron el total: se deshacen
+        for (int t : lista) {
+            sumar_al_estado(estado, cambios[t], -1);
+            for (auto it = cambios[t].deshacer.rbegin(); it != cambios[t].deshacer.rend(); ++it) {
+                zonas[it->first] = it->second;
+            }
+            estado.contadores().sumar(cambios[t].cuenta);
+            const Tesela& tesela = teselas[t];
+            for (int i = tesela.fila_ini; i < tesela.fila_fin; ++i) {
+                std::fill(pendiente.begin() + i * M + tesela.col_ini, pendiente.begin() + i * M + tesela.col_fin, 1);
+            }
+        }
+        fase_serial(lista);
+    };
+
+    while (!detenido) {
+        ++estado.contadores().pasadas;
+        std::fill(cambio.begin(), cambio.end(), 0);
+        bool hubo_cambios = false;
+
+        for (int color = 0; color < 4 && !detenido; ++color) {
+            std::vector<int> lista;
+            for (int t = 0; t < num_teselas; ++t) {
+                if (teselas[t].color == color && activa[t]) lista.push_back(t);
+            }
+            if (lista.empty()) continue;
+
+            fase_paralela(lista, std::min(num_hilos, static_cast<int>(lista.size())));
+
+            long long evaluados = 0;
+            for (int t : lista) {
+                evaluados += cambios[t].cuenta.movimientos_probados;
+                estado.contadores().sumar(cambios[t].cuenta);
+                if (!cambios[t].deshacer.empty()) {
+                    cambio[t] = 1;
+                    hubo_cambios = true;
+                }
+            }
+            if (presupuesto) {
+                if (presupuesto->consumir(evaluados)) detenido = true;
+                presupuesto->reportar_costo(estado.costo());
+            }
+
+            verificar("tras la fase " + std::to_string(color));
+        }
+
+        if (!hubo_cambios) {
+            if (todas_activas) {
+                // Ronda completa sin mejoras -> óptimo local, salvo que queden
+                // penalizaciones: entonces se prueba el vecindario completo
+                if (completo || conexo || !estado.penalizada()) break;
+                completo = true;
+            }
+            std::fill(activa.begin(), activa.end(), 1);
+            std::fill(pendiente.begin(), pendiente.end(), 1);
+            todas_activas = true;
+            continue;
+        }
+        completo = false;
+
+        // La ronda siguiente revisa las teselas que cambiaron y sus 8 vecinas
+        std::fill(activa.begin(), activa.end(), 0);
+        for (int ti = 0; ti < filas_teselas; ++ti) {
+            for (int tj = 0; tj < columnas_teselas; ++tj) {
+                if (!cambio[ti * columnas_teselas + tj]) continue;
+                for (int di = -1; di <= 1; ++di) {
+                    for (int dj = -1; dj <= 1; ++dj) {
+                        int vi = ti + di;
+                        int vj = tj + dj;
+                        if (vi >= 0 && vi < filas_teselas && vj >= 0 && vj < columnas_teselas) {
+                            activa[vi * columnas_teselas + vj] = 1;
+                        }
+                    }
+                }
+            }
+        }
+        todas_activas = false;
+    }
+
+    contadores_hilo().sumar(estado.contadores());
+
+    // Costo final exacto, con la misma función que reportamos al usuario
+    sol_actual.costo = evaluar_solucion(instancia, sol_actual, umbral_varianza);
+    return sol_actual;
+}
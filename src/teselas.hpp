@@ -0,0 +1,35 @@
+#pragma once
+
+#include "spp.hpp"
+
+/**
+ * @brief Hill Climbing de una sola solución repartido en teselas, en paralelo.
+ *
+ * El mapa se corta en teselas de `lado_tesela` x `lado_tesela` celdas,
+ * coloreadas con 4 colores según la paridad de (fila, columna) de tesela:
+ * dos teselas del mismo color nunca se tocan, ni en diagonal. Cada ronda
+ * tiene 4 fases, una por color; en una fase los hilos toman teselas de ese
+ * color y hacen First Improvement sobre sus celdas de frontera.
+ *
+ * Evaluar un movimiento lee hasta 2 celdas fuera de la tesela (islas de los
+ * vecinos): ese halo pertenece a teselas de otro color, quietas durante la
+ * fase, así que se lee directo de la solución compartida sin copias ni
+ * locks. Las estadísticas por zona sí son globales: cada tesela evalúa
+ * contra las de inicio de fase más sus propios cambios, y al terminar la
+ * fase los cambios de todas se suman en orden de tesela (el resultado no
+ * depende del número de hilos). Si la suma empeora el costo (dos teselas
+ * llevaron una zona sobre el umbral a la vez), la fase se deshace y se
+ * repite en serie.
+ *
+ * Solo se revisan las teselas que cambiaron, o cuyas vecinas cambiaron, en
+ * la ronda anterior; antes de terminar se hace una ronda con todas (y, si
+ * quedan penalizaciones, otra con el vecindario completo).
+ *
+ * Con `conexo` solo se aceptan salidas con desvío local en el anillo de 8
+ * vecinos (`ConectividadZonas::puede_salir_local`), porque la búsqueda
+ * acotada podría leer teselas que otro hilo está cambiando.
+ * Lanza std::runtime_error con una instancia multibanda.
+ */
+Solucion hill_climbing_teselas(const Instancia& instancia, Solucion sol_actual, double umbral_varianza,
+                               int num_hilos, int lado_tesela, bool verificar_delta = false,
+                               Presupuesto* presupuesto = nullptr, bool conexo = false);
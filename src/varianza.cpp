@@ -0,0 +1,222 @@
+#include "varianza.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Valores por bloque: 16 KB de float, caben en L1 para la segunda pasada
+constexpr std::size_t BLOQUE_VARIANZA = 4096;
+
+// Acumuladores independientes por pasada (ILP y vectorización sin -ffast-math)
+constexpr int CARRILES = 4;
+
+/**
+ * @brief Momentos de un bloque con dos pasadas: media y luego desvíos
+ * respecto de ella. El término sum(d)^2 / n corrige el error de redondeo de
+ * la media (algoritmo de dos pasadas corregido).
+ */
+MomentosVarianza momentos_bloque(const float* __restrict valores, std::size_t n) {
+    double s[CARRILES] = {};
+    std::size_t k = 0;
+    for (; k + CARRILES <= n; k += CARRILES) {
+        for (int c = 0; c < CARRILES; ++c) s[c] += valores[k + c];
+    }
+    double suma = (s[0] + s[1]) + (s[2] + s[3]);
+    for (; k < n; ++k) suma += valores[k];
+    double media = suma / static_cast<double>(n);
+
+    double d[CARRILES] = {};
+    double q[CARRILES] = {};
+    k = 0;
+    for (; k + CARRILES <= n; k += CARRILES) {
+        for (int c = 0; c < CARRILES; ++c) {
+            double desvio = valores[k + c] - media;
+            d[c] += desvio;
+            q[c] += desvio * desvio;
+        }
+    }
+    double suma_desvios = (d[0] + d[1]) + (d[2] + d[3]);
+    double suma_cuadrados = (q[0] + q[1]) + (q[2] + q[3]);
+    for (; k < n; ++k) {
+        double desvio = valores[k] - media;
+        suma_desvios += desvio;
+        suma_cuadrados += desvio * desvio;
+    }
+
+    MomentosVarianza resultado;
+    resultado.n = static_cast<long long>(n);
+    resultado.media = media + suma_desvios / static_cast<double>(n);
+    resultado.m2 = std::max(0.0, suma_cuadrados - suma_desvios * suma_desvios / static_cast<double>(n));
+    return resultado;
+}
+
+} // namespace
+
+void MomentosVarianza::combinar(const MomentosVarianza& otro) {
+    if (otro.n == 0) return;
+    if (n == 0) {
+        *this = otro;
+        return;
+    }
+    long long total = n + otro.n;
+    double delta = otro.media - media;
+    double peso = static_cast<double>(otro.n) / static_cast<double>(total);
+    media += delta * peso;
+    m2 += otro.m2 + delta * delta * static_cast<double>(n) * peso;
+    n = total;
+}
+
+void MomentosVarianza::quitar(const MomentosVarianza& parte) {
+    if (parte.n == 0) return;
+    long long resto = n - parte.n;
+    if (resto <= 0) {
+        *this = MomentosVarianza();
+        return;
+    }
+    double peso = static_cast<double>(parte.n) / static_cast<double>(resto);
+    double media_resto = media + (media - parte.media) * peso;
+    double delta = parte.media - media_resto;
+    m2 = std::max(0.0, m2 - parte.m2 - delta * delta * static_cast<double>(resto) * parte.n / n);
+    media = media_resto;
+    n = resto;
+}
+
+MomentosVarianza momentos(const float* valores, std::size_t n) {
+    MomentosVarianza total;
+    for (std::size_t inicio = 0; inicio < n; inicio += BLOQUE_VARIANZA) {
+        total.combinar(momentos_bloque(valores + inicio, std::min(BLOQUE_VARIANZA, n - inicio)));
+    }
+    return total;
+}
+
+void momentos_por_zona(const Instancia& instancia, const Grid<zona_t>& zonas, MomentosVarianza* por_zona) {
+    momentos_por_zona(instancia.datos_terreno, zonas, instancia.num_zonas, por_zona);
+}
+
+void momentos_por_zona(const Grid<float>& datos, const Grid<zona_t>& zonas, int num_zonas, MomentosVarianza* por_zona) {
+    std::fill(por_zona, por_zona + num_zonas, MomentosVarianza());
+
+    const int M = datos.columnas();
+    for (int i = 0; i < datos.filas(); ++i) {
+        const float* valores = &datos(i, 0);
+        const zona_t* fila = &zonas(i, 0);
+        int j = 0;
+        while (j < M) {
+            zona_t zona = fila[j];
+            int fin = j + 1;
+            while (fin < M && fila[fin] == zona) ++fin;
+            por_zona[zona].combinar(momentos(valores + j, static_cast<std::size_t>(fin - j)));
+            j = fin;
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+// IMPLEMENTACIÓN ORIGINAL, DE REFERENCIA
+// --------------------------------------------------------------------------
+
+double calcular_varianza_referencia(const std::vector<float>& valores) {
+    if (valores.empty() || valores.size() == 1) {
+        return 0.0; // Varianza de 0 o 1 elemento es 0.
+    }
+
+    double n = valores.size();
+
+    // Calcular la media
+    double suma = std::accumulate(valores.begin(), valores.end(), 0.0);
+    double media = suma / n;
+
+    // Calcular la suma de los cuadrados de las diferencias
+    double suma_cuadrados_dif = 0.0;
+    for (float val : valores) {
+        suma_cuadrados_dif += std::pow(val - media, 2);
+    }
+
+    return suma_cuadrados_dif / n;
+}
+
+double calcular_varianza_total_referencia(const Instancia& instancia) {
+    std::vector<float> full_data;
+    for (int i = 0; i < instancia.N_filas; ++i) {
+        for (int j = 0; j < instancia.M_columnas; ++j) {
+            full_data.push_back(instancia.datos_terreno(i, j));
+        }
+    }
+    return calcular_varianza_referencia(full_data);
+}
+
+double evaluar_solucion_referencia(const Instancia& instancia, const Solucion& solucion, double umbral_varianza) {
+    // Usamos un map para agrupar todos los valores que pertenecen a cada zona
+    std::map<int, std::vector<float>> valores_por_zona;
+    for (int i = 0; i < instancia.N_filas; ++i) {
+        for (int j = 0; j < instancia.M_columnas; ++j) {
+            valores_por_zona[solucion.zonas_asignadas(i, j)].push_back(instancia.datos_terreno(i, j));
+        }
+    }
+
+    double costo_total = 0.0;
+    double penalizacion_homogeneidad = 0.0;
+    for (int k = 0; k < instancia.num_zonas; ++k) {
+        double varianza_zona = calcular_varianza_referencia(valores_por_zona[k]);
+        costo_total += varianza_zona;
+        if (varianza_zona > umbral_varianza) {
+            penalizacion_homogeneidad += (varianza_zona - umbral_varianza) * PENALIZACION_HOMOGENEIDAD;
+        }
+    }
+
+    // Islas: celdas con vecinos, ninguno de su zona
+    double penalizacion_islas = 0.0;
+    int dr[] = {-1, 1, 0, 0};
+    int dc[] = {0, 0, -1, 1};
+    for (int i = 0; i < instancia.N_filas; ++i) {
+        for (int j = 0; j < instancia.M_columnas; ++j) {
+            int mi_zona = solucion.zonas_asignadas(i, j);
+            bool tengo_vecino_igual = false;
+            int vecinos_validos = 0;
+            for (int d = 0; d < 4; ++d) {
+                int ni = i + dr[d];
+                int nj = j + dc[d];
+                if (ni >= 0 && ni < instancia.N_filas && nj >= 0 && nj < instancia.M_columnas) {
+                    vecinos_validos++;
+                    if (solucion.zonas_asignadas(ni, nj) == mi_zona) {
+                        tengo_vecino_igual = true;
+                        break;
+                    }
+                }
+            }
+            if (vecinos_validos > 0 && !tengo_vecino_igual) {
+                penalizacion_islas += M_ISLA;
+            }
+        }
+    }
+
+    return costo_total + penalizacion_homogeneidad + penalizacion_islas;
+}
+
+void validar_varianzas(const Instancia& instancia, const Solucion& solucion, double umbral_varianza,
+                       double tolerancia) {
+    auto comparar = [&](const std::string& nombre, double nueva, double referencia) {
+        double diferencia = std::fabs(nueva - referencia) / std::max(1e-300, std::fabs(referencia));
+        std::cout << "Validacion " << nombre << ": nueva = " << nueva << ", referencia = " << referencia
+                  << ", dif. relativa = " << diferencia << std::endl;
+        if (!(diferencia <= tolerancia)) {
+            throw std::runtime_error(nombre + " difiere de la implementacion de referencia (dif. relativa " +
+                                     std::to_string(diferencia) + ")");
+        }
+    };
+
+    comparar("calcular_varianza_total", calcular_varianza_total(instancia), calcular_varianza_total_referencia(instancia));
+    // Sin umbral para comparar el costo sin la penalización de 1e9, que amplifica el redondeo
+    double sin_umbral = std::numeric_limits<double>::infinity();
+    comparar("evaluar_solucion (sin penalizacion)", evaluar_solucion(instancia, solucion, sin_umbral),
+             evaluar_solucion_referencia(instancia, solucion, sin_umbral));
+    comparar("evaluar_solucion", evaluar_solucion(instancia, solucion, umbral_varianza),
+             evaluar_solucion_referencia(instancia, solucion, umbral_varianza));
+}
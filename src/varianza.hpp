@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "spp.hpp"
+
+/**
+ * @struct MomentosVarianza
+ * @brief Conteo, media y suma de desvíos al cuadrado (M2) de un conjunto de
+ * valores; la varianza poblacional es M2 / n.
+ *
+ * Se acumula por bloques: cada bloque se resume con dos pasadas en caché
+ * (media y luego desvíos respecto de ella) y los resúmenes se combinan con
+ * la fórmula de Chan et al. Así no se resta nunca sum(x^2)/n - media^2, que
+ * pierde precisión cuando la media es grande frente a la dispersión.
+ */
+struct MomentosVarianza {
+    long long n = 0;
+    double media = 0.0;
+    double m2 = 0.0;
+
+    void combinar(const MomentosVarianza& otro);
+    void quitar(const MomentosVarianza& parte);   // Inversa de combinar: `parte` debe estar contenida
+    double varianza() const { return n > 1 ? m2 / n : 0.0; }
+};
+
+/**
+ * @brief Momentos de `n` valores contiguos, en una pasada por bloques y sin
+ * memoria extra.
+ */
+MomentosVarianza momentos(const float* valores, std::size_t n);
+
+/**
+ * @brief Momentos de cada zona de la solución directamente sobre la grilla:
+ * recorre cada fila por tramos de celdas consecutivas de la misma zona y
+ * combina cada tramo en `por_zona[zona]`. `por_zona` debe tener
+ * `instancia.num_zonas` entradas, que se reinician.
+ */
+void momentos_por_zona(const Instancia& instancia, const Grid<zona_t>& zonas, MomentosVarianza* por_zona);
+
+/**
+ * @brief Igual que la anterior, para una zonificación con `num_zonas` zonas
+ * que no tiene por qué coincidir con la de una instancia (ver barrido.hpp).
+ */
+void momentos_por_zona(const Grid<float>& datos, const Grid<zona_t>& zonas, int num_zonas, MomentosVarianza* por_zona);
+
+// --------------------------------------------------------------------------
+// IMPLEMENTACIÓN ORIGINAL, DE REFERENCIA (copias en vectores, dos pasadas)
+// --------------------------------------------------------------------------
+double calcular_varianza_referencia(const std::vector<float>& valores);
+double calcular_varianza_total_referencia(const Instancia& instancia);
+double evaluar_solucion_referencia(const Instancia& instancia, const Solucion& solucion, double umbral_varianza);
+
+/**
+ * @brief Compara `calcular_varianza_total` y `evaluar_solucion` con la
+ * implementación de referencia sobre `solucion`. Imprime ambos valores y la
+ * diferencia relativa, y lanza std::runtime_error si supera `tolerancia`.
+ */
+void validar_varianzas(const Instancia& instancia, const Solucion& solucion, double umbral_varianza,
+                       double tolerancia = 1e-9);